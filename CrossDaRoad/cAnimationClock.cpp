@@ -0,0 +1,174 @@
+#include "cAnimationClock.h"
+#include "cAssetManager.h"
+#include <cmath>
+#include <iostream>
+
+/**
+ * @file cAnimationClock.cpp
+ *
+ * @brief Contains animation clock class implementation
+ *
+ * This file implements animation clock class. Sprite handles are looked up by name once, when an
+ * animation is registered, and the frames of each animation follow the same tick grid as its frame
+ * time, so animations with the same frame time always step together.
+**/
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// CONSTRUCTORS & DESTRUCTOR ////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Default constructor, no animation registered
+cAnimationClock::cAnimationClock()
+{
+	fTime = 0.0f;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// REGISTRATION //////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Register an animation, looking up the sprite handles of its frames
+/// @param sName Name of the frame sprites "<sName>1".."<sName>N" (empty if the frames have no sprite)
+/// @param nFrameCount Number of frames
+/// @param fFrameTime Duration of a frame (in seconds)
+/// @param eMode Loop or play once (a ONCE animation waits for Restart)
+/// @return ID of the animation, -1 if the frame count or the frame time is not positive
+AnimationId cAnimationClock::Register(const std::string& sName, const int nFrameCount, const float fFrameTime, const Mode eMode)
+{
+	if (nFrameCount <= 0 || fFrameTime <= 0) {
+		std::cerr << "cAnimationClock::Register(" << sName << ", " << nFrameCount << ", " << fFrameTime << ") ";
+		std::cerr << "expected a positive frame count and frame time" << std::endl;
+		return -1;
+	}
+	Animation animation{};
+	animation.fFrameTime = fFrameTime;
+	animation.nFrameCount = nFrameCount;
+	animation.eMode = eMode;
+	animation.bSprites = !sName.empty();
+	animation.bStarted = (eMode == LOOP);
+	if (animation.bSprites) {
+		// Slot 0 is kept empty so frame ID indexes directly, as in cMapRuntime
+		animation.uFrameOffset = static_cast<uint32_t>(vecFrames.size());
+		vecFrames.push_back(nullptr);
+		for (int nFrame = 1; nFrame <= nFrameCount; nFrame++) {
+			vecFrames.push_back(cAssetManager::GetInstance().GetSprite(sName + std::to_string(nFrame)));
+		}
+	}
+	animation.nTick = static_cast<int>(std::floor(fTime / fFrameTime));
+	UpdateFrame(animation);
+	vecAnimations.push_back(animation);
+	return static_cast<AnimationId>(vecAnimations.size()) - 1;
+}
+
+/// @brief Getter for a looping animation without sprite, registered on first use and shared afterwards
+/// @param nFrameCount Number of frames
+/// @param fFrameTime Duration of a frame (in seconds)
+/// @return ID of the animation, -1 if the frame count or the frame time is not positive
+AnimationId cAnimationClock::GetLoop(const int nFrameCount, const float fFrameTime)
+{
+	for (size_t uAnimation = 0; uAnimation < vecAnimations.size(); uAnimation++) {
+		const Animation& animation = vecAnimations[uAnimation];
+		if (animation.eMode == LOOP && !animation.bSprites && animation.nFrameCount == nFrameCount && animation.fFrameTime == fFrameTime) {
+			return static_cast<AnimationId>(uAnimation);
+		}
+	}
+	return Register("", nFrameCount, fFrameTime, LOOP);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// UPDATE ////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Advance all animations to the current time, once per simulation tick
+/// @param fCurrentTime Current simulation time (in seconds)
+void cAnimationClock::Update(const float fCurrentTime)
+{
+	fTime = fCurrentTime;
+	for (Animation& animation : vecAnimations) {
+		animation.nTick = static_cast<int>(std::floor(fTime / animation.fFrameTime));
+		UpdateFrame(animation);
+	}
+}
+
+/// @brief Start an animation from its first frame at the current tick
+/// @param nAnimation ID of the animation
+void cAnimationClock::Restart(const AnimationId nAnimation)
+{
+	if (!IsValid(nAnimation)) {
+		return;
+	}
+	Animation& animation = vecAnimations[nAnimation];
+	animation.nStartTick = animation.nTick;
+	animation.bStarted = true;
+	UpdateFrame(animation);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// GETTERS ///////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if an animation ID was returned by Register
+bool cAnimationClock::IsValid(const AnimationId nAnimation) const
+{
+	return 0 <= nAnimation && nAnimation < static_cast<AnimationId>(vecAnimations.size());
+}
+/// @brief Check if a ONCE animation went past its last frame
+bool cAnimationClock::IsFinished(const AnimationId nAnimation) const
+{
+	return IsValid(nAnimation) && vecAnimations[nAnimation].nFrame > vecAnimations[nAnimation].nFrameCount;
+}
+/// @brief Getter for the current frame ID of an animation
+/// @return 1..frame count, 0 if not started or invalid, beyond the frame count if a ONCE animation finished
+int cAnimationClock::GetFrame(const AnimationId nAnimation) const
+{
+	return IsValid(nAnimation) ? vecAnimations[nAnimation].nFrame : 0;
+}
+/// @brief Getter for the number of frames of an animation (0 if invalid)
+int cAnimationClock::GetFrameCount(const AnimationId nAnimation) const
+{
+	return IsValid(nAnimation) ? vecAnimations[nAnimation].nFrameCount : 0;
+}
+/// @brief Getter for the frames elapsed since time 0 at the frame time of an animation (0 if invalid)
+int cAnimationClock::GetTick(const AnimationId nAnimation) const
+{
+	return IsValid(nAnimation) ? vecAnimations[nAnimation].nTick : 0;
+}
+/// @brief Getter for the sprite handle of the current frame of an animation
+/// @return Sprite handle, nullptr if the animation has no sprite or is not on one of its frames
+const app::Sprite* cAnimationClock::GetSprite(const AnimationId nAnimation) const
+{
+	return GetFrameSprite(nAnimation, GetFrame(nAnimation));
+}
+/// @brief Getter for the sprite handle of a frame of an animation
+/// @param nAnimation ID of the animation
+/// @param nFrame Frame ID (1..frame count)
+/// @return Sprite handle, nullptr if the animation has no sprite or the frame is out of range
+const app::Sprite* cAnimationClock::GetFrameSprite(const AnimationId nAnimation, const int nFrame) const
+{
+	if (!IsValid(nAnimation)) {
+		return nullptr;
+	}
+	const Animation& animation = vecAnimations[nAnimation];
+	if (!animation.bSprites || nFrame <= 0 || nFrame > animation.nFrameCount) {
+		return nullptr;
+	}
+	return vecFrames[animation.uFrameOffset + nFrame];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// HELPERS ///////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Compute the current frame ID of an animation from its tick
+void cAnimationClock::UpdateFrame(Animation& animation)
+{
+	if (!animation.bStarted) {
+		animation.nFrame = 0;
+	}
+	else if (animation.eMode == LOOP) {
+		animation.nFrame = animation.nTick % animation.nFrameCount + 1;
+	}
+	else {
+		animation.nFrame = animation.nTick - animation.nStartTick + 1;
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef C_ANIMATION_CLOCK_H
+#define C_ANIMATION_CLOCK_H
+
+#include "gSprite.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file cAnimationClock.h
+ *
+ * @brief Contains animation clock class
+ *
+ * This file contains animation clock class that advances all registered animations from the simulation
+ * time, once per tick, and keeps the sprite handles of their frames so drawing a frame is an array load.
+**/
+
+/// @brief ID of an animation registered to the animation clock (-1 if none)
+using AnimationId = int;
+
+/// @brief Class for advancing sprite animations on the simulation time
+class cAnimationClock
+{
+public:
+	/// @brief How an animation goes on after its last frame
+	enum Mode
+	{
+		LOOP, ///< Back to the first frame
+		ONCE, ///< Frame ID goes on past the frame count (finished), until restarted
+	};
+
+private:
+	/// @brief Timing and current frame of a registered animation
+	struct Animation
+	{
+		float fFrameTime;      ///< Duration of a frame (in seconds)
+		int nFrameCount;       ///< Number of frames
+		Mode eMode;            ///< Loop or play once
+		bool bSprites;         ///< If the frames have sprite handles (otherwise the owner picks the sprite)
+		uint32_t uFrameOffset; ///< Offset of the slot 0 of the animation in the frame pool
+		int nStartTick;        ///< Tick of the first frame (ONCE)
+		bool bStarted;         ///< If the animation is playing (ONCE, always true for LOOP)
+		int nTick;             ///< Frames elapsed since time 0 (floor(time / frame time))
+		int nFrame;            ///< Current frame ID (1..nFrameCount, 0 if not started, beyond if finished)
+	};
+
+private:
+	std::vector<Animation> vecAnimations;      ///< Registered animations (key: animation ID)
+	std::vector<const app::Sprite*> vecFrames; ///< Frame handles of all animations with sprites
+	float fTime; ///< Simulation time of the last update (in seconds)
+
+public: // Constructors & Destructor
+	cAnimationClock();
+	~cAnimationClock() = default;
+
+public: // Registration
+	AnimationId Register(const std::string& sName, int nFrameCount, float fFrameTime, Mode eMode = LOOP);
+	AnimationId GetLoop(int nFrameCount, float fFrameTime);
+
+public: // Update
+	void Update(float fCurrentTime);
+	void Restart(AnimationId nAnimation);
+
+public: // Getters
+	bool IsValid(AnimationId nAnimation) const;
+	bool IsFinished(AnimationId nAnimation) const;
+	int GetFrame(AnimationId nAnimation) const;
+	int GetFrameCount(AnimationId nAnimation) const;
+	int GetTick(AnimationId nAnimation) const;
+	const app::Sprite* GetSprite(AnimationId nAnimation) const;
+	const app::Sprite* GetFrameSprite(AnimationId nAnimation, int nFrame) const;
+
+private:
+	static void UpdateFrame(Animation& animation);
+};
+
+#endif // C_ANIMATION_CLOCK_H
@@ -1,7 +1,7 @@
 #include "cApp.h"
+#include "gTrace.h"
 #include "uSound.h"
 #include "uStringUtils.h"
-#include <Windows.h>
 #include <algorithm>
 #include <iostream>
 #include <sstream>
@@ -41,6 +41,7 @@ bool cApp::GameInit()
 	nLaneWidth = LANE_WIDTH;
 	nCellSize = CELL_SIZE;
 	nScore = 0;
+	arrTileAnimations.fill(-1);
 	MapLoader.Init();
 	return true;
 }
@@ -70,11 +71,28 @@ bool cApp::GameReset()
 	fTimeSinceStart = 0.0f;
 
 	sAppName = "Cross Da Road " + MapLoader.ShowMapInfo();
-	Zone.CreateZone(ScreenWidth(), ScreenHeight());
+	Collision.Create(ScreenWidth(), ScreenHeight(), nCellSize, nLaneWidth);
+	fSweepTime = -1.0f;
+	bDeath = false;
 	Player.Reset();
 
 	Clear(app::BLACK);
 	MapLoader.LoadMapLevel();
+	bPixelCollision = MapLoader.GetMapLevel() >= app_const::PIXEL_COLLISION_LEVEL;
+	Summon.Reset(MapLoader.GetRuntime(), GetRandomStream(app_const::RANDOM_SUMMON_DOMAIN, MapLoader.GetMapLevel()));
+	// Animated tiles with the same frame count share a loop of the animation clock
+	arrTileAnimations.fill(-1);
+	vecTileAnimations.clear();
+	for (int nTile = 0; nTile < cMapRuntime::TILE_COUNT; nTile++) {
+		const MapTile& tile = MapLoader.GetRuntime().GetTile(static_cast<uint8_t>(nTile));
+		if (tile.IsAnimated() && arrTileAnimations[tile.uFrameCount] < 0) {
+			arrTileAnimations[tile.uFrameCount] = Animation.GetLoop(tile.uFrameCount, app_const::LOOP_FRAME_TIME);
+			vecTileAnimations.push_back(arrTileAnimations[tile.uFrameCount]);
+		}
+	}
+	if (!MapLoader.GetDiagnostics().empty()) {
+		std::cerr << MapLoader.ShowDiagnostics();
+	}
 	return true;
 }
 
@@ -85,20 +103,16 @@ bool cApp::GameReset()
 /// @brief 
 ///	@param x - X position of Player
 ///	@param y - Y position of Player
-///	@return SpriteData of hitbox of Player
-SpriteData cApp::GetHitBox(float x, float y) const
+///	@return MapTile of hitbox of Player
+const MapTile& cApp::GetHitBox(float x, float y) const
 {
-	const cLane lane = MapLoader.GetLaneRound(y);
-	int nStartPos = static_cast<int>(x + fTimeSinceLastDrawn * lane.GetVelocity()) % app_const::MAP_WIDTH_LIMIT;
-	const int nCellOffset = static_cast<int>(static_cast<float>(nCellSize) * fTimeSinceStart * lane.GetVelocity()) % nCellSize;
-	if (nStartPos < 0) {
-		nStartPos = app_const::MAP_WIDTH_LIMIT - (abs(nStartPos) % app_const::MAP_WIDTH_LIMIT);
-	}
-	const char graphic = lane.GetLane()[(nStartPos) % app_const::MAP_WIDTH_LIMIT];
-	return MapLoader.GetSpriteData(graphic);
+	const cMapRuntime& runtime = MapLoader.GetRuntime();
+	const int nRow = static_cast<int>(std::round(y));
+	const int nStartPos = static_cast<int>(x + fTimeSinceStart * runtime.GetLaneVelocity(nRow));
+	return runtime.GetTile(runtime.GetLaneTile(nRow, nStartPos));
 }
 /// @brief 
-SpriteData cApp::GetHitBox() const
+const MapTile& cApp::GetHitBox() const
 {
 	const float fPosX = Player.GetPlayerLogicPositionX();
 	const float fPosY = Player.GetPlayerLogicPositionY();
@@ -116,21 +130,25 @@ bool cApp::IsKilled(bool bDebug) const
 		return false;
 	}
 
-	const SpriteData dataLeft = GetHitBox(fPosX - nCellSize / 2.0f, fPosY);
-	const SpriteData dataRight = GetHitBox(fPosX + nCellSize / 2.0f, fPosY);
+	const MapTile& dataLeft = GetHitBox(fPosX - nCellSize / 2.0f, fPosY);
+	const MapTile& dataRight = GetHitBox(fPosX + nCellSize / 2.0f, fPosY);
 	if (bDebug) {
-		std::cerr << "Left touching[" << dataLeft.encode << "]: ";
-		std::cerr << "sprite \"" << dataLeft.sSpriteName << "\" ";
-		std::cerr << "background = \"" << dataLeft.sBackgroundName << "\" ";
+		const cMapRuntime& runtime = MapLoader.GetRuntime();
+		const MapTileInfo& infoLeft = runtime.GetTileInfo(dataLeft.uEncode);
+		const MapTileInfo& infoRight = runtime.GetTileInfo(dataRight.uEncode);
+		const float fLaneVelocity = runtime.GetLaneVelocity(static_cast<int>(std::round(fPosY)));
+		std::cerr << "Left touching[" << infoLeft.encode << "]: ";
+		std::cerr << "sprite \"" << infoLeft.sSpriteName << "\" ";
+		std::cerr << "background = \"" << infoLeft.sBackgroundName << "\" ";
 		std::cerr << "platform speed = " << dataLeft.fPlatform << " ";
-		std::cerr << "lane speed = " << MapLoader.GetLaneRound(fPosY).GetVelocity() << " ";
+		std::cerr << "lane speed = " << fLaneVelocity << " ";
 		std::cerr << "is Player jumping safe = " << std::boolalpha << Player.IsPlayerCollisionSafe() << " ";
 		std::cerr << std::endl;
-		std::cerr << "Right touching[" << dataRight.encode << "]: ";
-		std::cerr << "sprite \"" << dataRight.sSpriteName << "\" ";
-		std::cerr << "background = \"" << dataRight.sBackgroundName << "\" ";
+		std::cerr << "Right touching[" << infoRight.encode << "]: ";
+		std::cerr << "sprite \"" << infoRight.sSpriteName << "\" ";
+		std::cerr << "background = \"" << infoRight.sBackgroundName << "\" ";
 		std::cerr << "platform speed = " << dataRight.fPlatform << " ";
-		std::cerr << "lane speed = " << MapLoader.GetLaneRound(fPosY).GetVelocity() << " ";
+		std::cerr << "lane speed = " << fLaneVelocity << " ";
 		std::cerr << "is Player jumping safe = " << std::boolalpha << Player.IsPlayerCollisionSafe() << " ";
 		std::cerr << std::endl;
 	}
@@ -142,16 +160,44 @@ bool cApp::IsKilled(bool bDebug) const
 
 	return true;
 }
+/// @brief Check if a danger tile swept through Player since the last check, while Player moved from its last checked position
+/// @return true if Player was touched in between (pixel-perfect if enabled for the map), false otherwise
+bool cApp::IsKilledSinceLastCheck()
+{
+	const float fPosX = Player.GetPlayerLogicPositionX();
+	const float fPosY = Player.GetPlayerLogicPositionY();
+	const bool isChecked = fSweepTime >= 0;
+	const float fTimeFrom = fSweepTime;
+	const float fPosXFrom = fSweepPosX;
+	const float fPosYFrom = fSweepPosY;
+	fSweepTime = fTimeSinceStart;
+	fSweepPosX = fPosX;
+	fSweepPosY = fPosY;
+	if (!isChecked || Player.IsPlayerCollisionSafe()) {
+		return false;
+	}
+
+	float fContactTime = 0;
+	if (bPixelCollision) {
+		const float fSize = static_cast<float>(nCellSize);
+		return Collision.SweepDangerMask(Player.GetPlayerMask(),
+										 static_cast<int>(fPosXFrom * fSize), static_cast<int>(fPosYFrom * fSize),
+										 static_cast<int>(fPosX * fSize), static_cast<int>(fPosY * fSize),
+										 fTimeFrom, fTimeSinceStart, fContactTime);
+	}
+	return Collision.SweepDanger(fPosXFrom, fPosYFrom, fPosX, fPosY, nCellSize, fTimeFrom, fTimeSinceStart, fContactTime);
+}
 /// @brief 
 /// @return 
 std::string cApp::GetPlayerDeathMessage() const
 {
 	float fPosX = Player.GetPlayerLogicPositionX();
 	float fPosY = Player.GetPlayerLogicPositionY();
-	const SpriteData leftData = GetHitBox(fPosX - nCellSize / 2.0f, fPosY);
-	const SpriteData rightData = GetHitBox(fPosX + nCellSize / 2.0f, fPosY);
-	const std::string sLeft = leftData.sSpriteName;
-	const std::string sRight = rightData.sSpriteName;
+	const cMapRuntime& runtime = MapLoader.GetRuntime();
+	const MapTile& leftData = GetHitBox(fPosX - nCellSize / 2.0f, fPosY);
+	const MapTile& rightData = GetHitBox(fPosX + nCellSize / 2.0f, fPosY);
+	const std::string& sLeft = runtime.GetTileInfo(leftData.uEncode).sSpriteName;
+	const std::string& sRight = runtime.GetTileInfo(rightData.uEncode).sSpriteName;
 
 	if (sLeft.empty() && sRight.empty()) {
 		return "Player has been force killed";
@@ -172,8 +218,7 @@ bool cApp::IsPlatformLeft() const
 {
 	const float fPosX = Player.GetPlayerLogicPositionX();
 	const float fPosY = Player.GetPlayerLogicPositionY();
-	const SpriteData leftData = GetHitBox(fPosX - nCellSize / 2.0f, fPosY);
-	return !leftData.sSpriteName.empty() && std::fabs(leftData.fPlatform) > 0;
+	return GetHitBox(fPosX - nCellSize / 2.0f, fPosY).IsPlatform();
 }
 /// @brief 
 /// @return 
@@ -181,8 +226,7 @@ bool cApp::IsPlatformRight() const
 {
 	const float fPosX = Player.GetPlayerLogicPositionX();
 	const float fPosY = Player.GetPlayerLogicPositionY();
-	const SpriteData rightData = GetHitBox(fPosX + nCellSize / 2.0f, fPosY);
-	return !rightData.sSpriteName.empty() && std::fabs(rightData.fPlatform) > 0;
+	return GetHitBox(fPosX + nCellSize / 2.0f, fPosY).IsPlatform();
 }
 /// @brief 
 /// @return 
@@ -190,8 +234,7 @@ bool cApp::IsPlatformCenter() const
 {
 	const float fPosX = Player.GetPlayerLogicPositionX();
 	const float fPosY = Player.GetPlayerLogicPositionY();
-	const SpriteData rightData = GetHitBox(fPosX, fPosY);
-	return !rightData.sSpriteName.empty() && std::fabs(rightData.fPlatform) > 0;
+	return GetHitBox(fPosX, fPosY).IsPlatform();
 }
 /// @brief 
 /// @return 
@@ -207,7 +250,7 @@ bool cApp::IsOnPlatform() const
 float cApp::GetPlatformVelocity(const float fElapsedTime) const
 {
 	const float fPosY = Player.GetPlayerLogicPositionY();
-	const float fVelocityX = MapLoader.GetLaneRound(fPosY).GetVelocity();
+	const float fVelocityX = MapLoader.GetRuntime().GetLaneVelocity(static_cast<int>(std::round(fPosY)));
 	const float fMovedX = fVelocityX * fElapsedTime;
 	return fMovedX;
 }
@@ -216,11 +259,33 @@ float cApp::GetPlatformVelocity(const float fElapsedTime) const
 ////////////////////////////////////// GAME UPDATES //////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief Advance summoned tiles and collision queries to the simulation time
+bool cApp::OnLaneUpdate()
+{
+	TRACE_FUNCTION();
+	const cMapRuntime& runtime = MapLoader.GetRuntime();
+	Summon.Update(runtime, fTimeSinceStart);
+	Collision.Update(runtime, fTimeSinceStart);
+	for (const AnimationId nAnimation : vecTileAnimations) {
+		Collision.SetDrawnFrame(Animation.GetFrameCount(nAnimation), Animation.GetFrame(nAnimation));
+	}
+	return true;
+}
 /// @brief 
 /// @param fElapsedTime 
 /// @return 
 bool cApp::OnPlayerUpdate(const float fElapsedTime)
 {
+	TRACE_FUNCTION();
+	if (bDeath) { // Lanes and Player are frozen until the death animation ends
+		return OnPlayerDeathUpdate(fElapsedTime);
+	}
+	OnLaneUpdate();
+	Player.OnBeginUpdate();
+	if (IsKeyReleased(app::Key::C)) {
+		bPixelCollision = !bPixelCollision;
+		std::cerr << "Pixel-perfect collision: " << (bPixelCollision ? "on" : "off") << std::endl;
+	}
 	Player.OnPlayerMove();
 	if (IsOnPlatform()) { // Frog is moved by platforms
 		Player.PlayerPlatformMove(-GetPlatformVelocity(fElapsedTime), 0);
@@ -229,27 +294,48 @@ bool cApp::OnPlayerUpdate(const float fElapsedTime)
 	if (Player.IsPlayerWin()) {
 		return GameNext();
 	}
-	if (Player.IsPlayerOutOfBounds() || IsKilled(true)) {
+	if (Player.IsPlayerOutOfBounds() || IsKilled(true) || IsKilledSinceLastCheck()) {
 		return OnPlayerDeath();
 	}
 	return true;
 }
-/// @brief 
-/// @return 
+/// @brief Start the death animation, Player is reset when it ends (see OnPlayerDeathUpdate)
 bool cApp::OnPlayerDeath()
 {
 	std::cerr << GetPlayerDeathMessage() << std::endl;
 	bDeath = true;
-	Player.OnRenderPlayerDeath();
-	Player.Reset();
-	bDeath = false;
+	fDeathTime = 0.0f;
+	return true;
+}
+/// @brief Advance the death animation on the simulation time, reset Player after its last frame
+/// @param fElapsedTime - Time elapsed since last update
+bool cApp::OnPlayerDeathUpdate(const float fElapsedTime)
+{
+	fDeathTime += fElapsedTime;
+	if (fDeathTime >= app_const::DEATH_FRAMES * app_const::DEATH_FRAME_TIME) {
+		Player.Reset();
+		fSweepTime = -1.0f;
+		bDeath = false;
+	}
 	return true;
 }
-/// @brief Draw all lanes, render Player, draw status bar
+/// @brief Getter for the frame of the death animation shown at the death time
+/// @return Frame ID (1..DEATH_FRAMES)
+int cApp::GetDeathFrame() const
+{
+	const int nFrame = 1 + static_cast<int>(fDeathTime / app_const::DEATH_FRAME_TIME);
+	return std::min(nFrame, app_const::DEATH_FRAMES);
+}
+/// @brief Draw all lanes, render Player (or its death frame), draw status bar
 bool cApp::OnGameUpdate()
 {
 	DrawAllLanes();
-	Player.OnRenderPlayer();
+	if (bDeath) {
+		Player.OnRenderPlayerDeath(GetDeathFrame());
+	}
+	else {
+		Player.OnRenderPlayer();
+	}
 	DrawStatusBar();
 	return true;
 }
@@ -257,7 +343,17 @@ bool cApp::OnGameUpdate()
 bool cApp::OnCreateEvent()
 {
 	SetFrameDelay(FrameDelay::STABLE_FPS_DELAY);
+	SetFixedTimeStep(1.0f / app_const::SIMULATION_RATE);
+	SetSimulationThread(app_const::SIMULATION_THREAD);
+	SetFrameGovernor(app_const::FRAME_GOVERNOR);
 	cAssetManager::GetInstance().LoadAllSprites();
+	Player.LoadSprites();
+	nAboutUsAnimation = Animation.Register("about_us_page", app_const::ABOUT_US_FRAMES, app_const::LOOP_FRAME_TIME);
+	nScoreBarAnimation = Animation.Register("score_bar", app_const::SCORE_BAR_FRAMES, app_const::LOOP_FRAME_TIME);
+	if (IsReplaying()) { // Start at the level of the recording
+		MapLoader.SetMapLevel(GetReplayLevel());
+	}
+	SetReplayLevel(MapLoader.GetMapLevel());
 	Menu.OpenMenu(this);
 	return true;
 }
@@ -266,9 +362,9 @@ bool cApp::OnCreateEvent()
 ///	@param eTickMessage - Tick message that contains information about tick
 bool cApp::OnFixedUpdateEvent(float fTickTime, const engine::Tick& eTickMessage)
 {
-	if (!bPause && !bDeath) {
+	if (!bPause && !bDeath && fTickTime != fTimeSinceStart) { // All ticks of a simulation step share its time
 		fTimeSinceStart = fTickTime;
-		Player.OnUpdateFrame(fTickTime);
+		Animation.Update(fTickTime);
 	}
 	return true;
 }
@@ -276,6 +372,25 @@ bool cApp::OnFixedUpdateEvent(float fTickTime, const engine::Tick& eTickMessage)
 ///	@parma fElapsedTime - Time elapsed since last update
 bool cApp::OnUpdateEvent(const float fElapsedTime)
 {
+	if (IsKeyReleased(app::Key::F3)) {
+		ToggleOverlay();
+	}
+	if (IsKeyReleased(app::Key::F9)) {
+		DumpProfile();
+		std::cerr << "Frame profile written to " << engine::PROFILE_CSV_FILE_PATH << " and " << engine::PROFILE_JSON_FILE_PATH << std::endl;
+	}
+	if (IsKeyReleased(app::Key::F10)) {
+		if (!IsTracing()) {
+			SetTracing(true);
+			std::cerr << "Trace started, press F10 again to write " << engine::TRACE_FILE_PATH << std::endl;
+		}
+		else {
+			SetTracing(false);
+			if (DumpTrace()) {
+				std::cerr << "Trace written to " << engine::TRACE_FILE_PATH << std::endl;
+			}
+		}
+	}
 	if (Menu.eAppOption == cMenu::Option::NEW_GAME) {
 		OnPlayerUpdate(fElapsedTime);
 	}
@@ -294,9 +409,7 @@ bool cApp::OnUpdateEvent(const float fElapsedTime)
 	}
 	else if (Menu.eAppOption == cMenu::Option::ABOUT_US) {
 		Clear(app::BLACK);
-		const std::string about_us_dynamic = "about_us_page" + Player.ShowFrameID(4);
-		const auto object = cAssetManager::GetInstance().GetSprite(about_us_dynamic);
-		DrawSprite(0, 0, object);
+		DrawSprite(0, 0, Animation.GetSprite(nAboutUsAnimation));
 
 		if (IsKeyReleased(app::Key::ESCAPE)) {
 			Menu.OpenMenu(this);
@@ -354,6 +467,7 @@ bool cApp::OnLateUpdateEvent(float fElapsedTime, float fLateElapsedTime)
 /// @brief Rendering menu and game (if game is running)
 bool cApp::OnRenderEvent()
 {
+	TRACE_FUNCTION();
 	if (Menu.eAppOption == cMenu::Option::NEW_GAME || Menu.eAppOption == cMenu::Option::CONTINUE) {
 		OnGameUpdate();
 	}
@@ -373,7 +487,8 @@ bool cApp::OnGameSave()
 			fout << Player.GetPlayerAnimationPositionX() << std::endl;
 			fout << Player.GetPlayerAnimationPositionY() << std::endl;
 			fout << Player.GetPlayerLogicPositionX() << std::endl;
-			fout << Player.GetPlayerLogicPositionY();
+			fout << Player.GetPlayerLogicPositionY() << std::endl;
+			fout << GetRandomSeed();
 			fout.close();
 			return true;
 		}
@@ -387,10 +502,15 @@ bool cApp::OnGameSave()
 		return false;
 	}
 }
-/// @brief 
-/// @return 
+/// @brief Load a saved game: its level and random seed are applied before the game is reset, then Player is restored
+/// @note Disabled while the session is recorded or replayed, a replay holds the key changes only, not the save file
+/// @return true if a save was loaded, false otherwise (the game is not reset)
 bool cApp::OnGameLoad()
 {
+	if (IsRecording() || IsReplaying()) {
+		std::cerr << "Saves can't be loaded while the session is recorded or replayed." << std::endl;
+		return false;
+	}
 	const std::string sFilePath = GetFilePartLocation(false);
 
 	if (!sFilePath.empty()) {
@@ -405,11 +525,17 @@ bool cApp::OnGameLoad()
 			int MapLevel;
 
 			if (fin >> MapLevel >> VelocityX >> VelocityY >> AnimationPositionX >> AnimationPositionY >> LogicPositionX >> LogicPositionY) {
+				uint64_t uRandomSeed;
+				if (fin >> uRandomSeed) { // Older saves have no seed
+					SetRandomSeed(uRandomSeed);
+				}
+				fin.close();
+				// The map and its summon stream are created from the loaded level and seed
 				MapLoader.SetMapLevel(MapLevel);
+				GameReset();
 				Player.SetPlayerAnimationPosition(AnimationPositionX, AnimationPositionY);
 				Player.SetPlayerLogicPosition(LogicPositionX, LogicPositionY);
 				Player.SetPlayerVelocity(VelocityX, VelocityY);
-				fin.close();
 				return true;
 			}
 			else {
@@ -430,8 +556,10 @@ bool cApp::OnGameLoad()
 bool cApp::OnPauseEvent()
 {
 	if (bPause || (Menu.eAppOption != cMenu::Option::APP_MENU && IsKeyReleased(app::Key::ESCAPE))) {
-		DisplayPauseMenu();
-		bPause = true;
+		if (!bPause) { // The pause menu is only redrawn when its selection changes
+			DisplayPauseMenu();
+			bPause = true;
+		}
 		// Load option pause menu
 		if (IsKeyReleased(app::Key::UP)) {
 			pauseOption--;
@@ -473,6 +601,17 @@ bool cApp::OnForceDestroyEvent()
 	GameExit();
 	return true;
 }
+/// @brief Hash the state the input drives (menus, level, score, Player), to verify a replay
+uint64_t cApp::OnStateHashEvent()
+{
+	app::StateHasher hasher;
+	hasher.Add(Menu.eAppOption).Add(Menu.nOption).Add(MapLoader.GetMapLevel()).Add(nScore);
+	hasher.Add(bPause).Add(bDeath).Add(fDeathTime).Add(pauseOption).Add(wantToExit).Add(fTimeSinceStart);
+	hasher.Add(Player.GetPlayerLogicPositionX()).Add(Player.GetPlayerLogicPositionY());
+	hasher.Add(Player.GetPlayerAnimationPositionX()).Add(Player.GetPlayerAnimationPositionY());
+	hasher.Add(Player.GetPlayerVelocityX()).Add(Player.GetPlayerVelocityY()).Add(Player.GetDirection());
+	return hasher.Get();
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////// FILE MANAGEMENT ///////////////////////////////////////////////
@@ -498,6 +637,7 @@ std::string cApp::SelectTextFilePath(const char* initialDir, const std::string&
 /// @return 
 std::string cApp::GetFilePartLocation(bool isSave)
 {
+#ifdef _WIN32
 	OPENFILENAME ofn;
 	wchar_t szFileNameW[MAX_PATH] = L"";
 	char szFileName[MAX_PATH] = "";
@@ -526,6 +666,9 @@ std::string cApp::GetFilePartLocation(bool isSave)
 		std::cout << "Selected File: " << szFileName << std::endl;
 		return szFileName;
 	}
+#else
+	return ""; // No file dialog on this platform
+#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -533,84 +676,68 @@ std::string cApp::GetFilePartLocation(bool isSave)
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// @brief Draw a lane to the screen
-///	@param lane - Lane to draw
 ///	@param nRow - Row to draw lane on
 ///	@param nCol - Column to draw lane on (default: -1)
 ///	@return true if lane was drawn successfully, false otherwise
-bool cApp::DrawLane(const cLane& lane, const int nRow, const int nCol = -1)
+bool cApp::DrawLane(const int nRow, const int nCol = -1)
 {
+	const cMapRuntime& runtime = MapLoader.GetRuntime();
+	const uint8_t* pLaneTiles = runtime.GetLaneTiles(nRow);
+	if (pLaneTiles == nullptr) {
+		return false;
+	}
+	const int nMapWidth = runtime.GetLaneWidth();
+	const bool bShedWork = IsSheddingWork();
+
 	// Find lane offset start
-	int nStartPos = static_cast<int>(fTimeSinceStart * lane.GetVelocity()) % app_const::MAP_WIDTH_LIMIT;
-	const int nCellOffset = static_cast<int>(static_cast<float>(nCellSize) * fTimeSinceStart * lane.GetVelocity()) % nCellSize;
-	if (nStartPos < 0)
-		nStartPos = app_const::MAP_WIDTH_LIMIT - (abs(nStartPos) % app_const::MAP_WIDTH_LIMIT);
+	const int nStartPos = runtime.GetLaneScrollTile(nRow, fTimeSinceLastDrawn);
+	const int nCellOffset = runtime.GetLaneScrollOffset(nRow, fTimeSinceLastDrawn, nCellSize);
+
+	constexpr int32_t nWidth = app_const::SPRITE_WIDTH;
+	constexpr int32_t nHeight = app_const::SPRITE_HEIGHT;
+	const int32_t nPosY = nRow * nCellSize;
+	auto GetTileAt = [&](const int nLaneIndex) -> const MapTile& {
+		return runtime.GetTile(pLaneTiles[(nStartPos + nLaneIndex) % nMapWidth]);
+		};
+	auto GetSpriteOf = [&](const MapTile& tile) {
+		return runtime.GetTileSprite(tile, tile.IsAnimated() ? Animation.GetFrame(arrTileAnimations[tile.uFrameCount]) : 0);
+		};
 
-	fTimeSinceLastDrawn = fTimeSinceStart;
-	auto drawCharacter = [&](const int nLaneIndex, SpriteData& sprite, const int sx, const int sy, bool drawBackground) {
+	SetPixelMode(app::Pixel::NORMAL);
+	for (int nLaneIndex = 0; nLaneIndex <= nLaneWidth; nLaneIndex++) {
+		const MapTile& tile = GetTileAt(nLaneIndex);
+		if (tile.pBackground) {
+			const int32_t nPosX = (nCol + nLaneIndex) * nCellSize;
+			DrawPartialSprite(nPosX, nPosY, tile.pBackground, tile.nBackgroundOriginX, tile.nBackgroundOriginY, nWidth, nHeight);
+		}
+	}
+	SetPixelMode(app::Pixel::MASK);
+	for (int nLaneIndex = 0; nLaneIndex <= nLaneWidth; nLaneIndex++) {
+		const MapTile& tile = GetTileAt(nLaneIndex);
 		const int32_t nPosX = (nCol + nLaneIndex) * nCellSize - nCellOffset;
-		const int32_t nPosY = nRow * nCellSize;
-		constexpr int32_t nWidth = app_const::SPRITE_WIDTH;
-		constexpr int32_t nHeight = app_const::SPRITE_HEIGHT;
-		if (drawBackground) {
-			const std::string sName = sprite.sBackgroundName;
-			if (sName.size()) {
-				const app::Sprite* background = cAssetManager::GetInstance().GetSprite(sName);
-				SetPixelMode(app::Pixel::NORMAL);
-				DrawPartialSprite(nPosX + nCellOffset, nPosY, background, sx, sy, nWidth, nHeight);
-				SetPixelMode(app::Pixel::NORMAL);
-			}
+		if (const app::Sprite* object = GetSpriteOf(tile)) {
+			DrawPartialSprite(nPosX, nPosY, object, tile.nSpriteOriginX, tile.nSpriteOriginY, nWidth, nHeight);
 		}
-		else {
-			const std::string sName = sprite.sSpriteName + (sprite.nID <= 0 ? "" : Player.ShowFrameID(sprite.nID));
-			if (sName.size()) {
-				const app::Sprite* object = cAssetManager::GetInstance().GetSprite(sName);
-				SetPixelMode(app::Pixel::MASK);
-				DrawPartialSprite(nPosX, nPosY, object, sx, sy, nWidth, nHeight);
-				SetPixelMode(app::Pixel::NORMAL);
-			}
-			if (sprite.SuccessSummon(nStartPos + nLaneIndex, nRow, fTimeSinceLastDrawn, GetAppFPS())) {
-				const std::string sSummonName = sprite.summon->sSpriteName + (sprite.summon->nID <= 0 ? "" : Player.ShowFrameID(sprite.summon->nID));
-				if (sSummonName.size()) {
-					const app::Sprite* summoned_object = cAssetManager::GetInstance().GetSprite(sSummonName);
-					SetPixelMode(app::Pixel::MASK);
-					DrawPartialSprite(nPosX, nPosY, summoned_object, sx, sy, nWidth, nHeight);
-					SetPixelMode(app::Pixel::NORMAL);
-				}
+		if (tile.IsSummon() && !bShedWork && Summon.IsActive(nRow, nStartPos + nLaneIndex, fTimeSinceLastDrawn)) { // Cosmetic only
+			const MapTile& summoned = runtime.GetTile(tile.uSummon);
+			if (const app::Sprite* summoned_object = GetSpriteOf(summoned)) {
+				DrawPartialSprite(nPosX, nPosY, summoned_object, tile.nSpriteOriginX, tile.nSpriteOriginY, nWidth, nHeight);
 			}
 		}
-		};
-	for (int nLaneIndex = 0; nLaneIndex <= nLaneWidth; nLaneIndex++) {
-		const char graphic = lane.GetLane()[(nStartPos + nLaneIndex) % app_const::MAP_WIDTH_LIMIT];
-		SpriteData data = MapLoader.GetSpriteData(graphic);
-		drawCharacter(nLaneIndex, data, data.nBackgroundPosX * app_const::SPRITE_WIDTH, data.nBackgroundPosY * app_const::SPRITE_HEIGHT, true);
-	}
-	for (int nLaneIndex = 0; nLaneIndex <= nLaneWidth; nLaneIndex++) {
-		const char graphic = lane.GetLane()[(nStartPos + nLaneIndex) % app_const::MAP_WIDTH_LIMIT];
-		SpriteData data = MapLoader.GetSpriteData(graphic);
-		drawCharacter(nLaneIndex, data, data.nSpritePosX * app_const::SPRITE_WIDTH, data.nSpritePosY * app_const::SPRITE_HEIGHT, false);
-	}
-	for (int nLaneIndex = 0; nLaneIndex <= nLaneWidth; nLaneIndex++) {
-		const char graphic = lane.GetLane()[(nStartPos + nLaneIndex) % app_const::MAP_WIDTH_LIMIT];
-		// Fill Danger buffer
-		const int nTopLeftX = (nCol + nLaneIndex) * nCellSize - nCellOffset;
-		const int nTopLeftY = nRow * nCellSize;
-		const int nBottomRightX = (nCol + nLaneIndex + 1) * nCellSize - nCellOffset;
-		const int nBottomRightY = (nRow + 1) * nCellSize;
-		// std::cerr << "block pattern: \"" << blockPattern << "\"" << std::endl;
-		Zone.FillDanger(nTopLeftX, nTopLeftY, nBottomRightX, nBottomRightY, graphic, MapLoader.GetDangerPattern().c_str());
-		Zone.FillBlocked(nTopLeftX, nTopLeftY, nBottomRightX, nBottomRightY, graphic, MapLoader.GetBlockPattern().c_str());
 	}
+	SetPixelMode(app::Pixel::NORMAL);
 	return true;
 }
-/// @brief Draw all lanes  to screen
+/// @brief Draw all lanes to screen, interpolated between the last two simulation steps
 bool cApp::DrawAllLanes()
 {
-	int nRow = 0;
-	const std::vector<cLane> vecLanes = MapLoader.GetLanes();
-	for (const cLane& lane : vecLanes) {
-		DrawLane(lane, nRow++);
+	TRACE_FUNCTION();
+	const float fRenderDelay = GetFixedTimeStep() * (1.0f - GetRenderAlpha());
+	fTimeSinceLastDrawn = std::max(fTimeSinceStart - fRenderDelay, 0.0f);
+	const int nLaneCount = MapLoader.GetRuntime().GetLaneCount();
+	for (int nRow = 0; nRow < nLaneCount; nRow++) {
+		DrawLane(nRow);
 	}
-
 	return true;
 }
 /// @brief Draw text to screen at (x, y) position
@@ -632,9 +759,7 @@ bool cApp::DrawBigText(const std::string& sText, const int x, const int y)
 /// @brief Draw the status bar beside the game map
 bool cApp::DrawStatusBar()
 {
-	const std::string score_board_dynamic = "score_bar" + Player.ShowFrameID(4);
-	const auto object = cAssetManager::GetInstance().GetSprite(score_board_dynamic);
-	DrawPartialSprite(272, 0, object, 0, 0, 80, 160);
+	DrawPartialSprite(272, 0, Animation.GetSprite(nScoreBarAnimation), 0, 0, 80, 160);
 	SetPixelMode(app::Pixel::MASK);
 	DrawBigText(MapLoader.ShowMapLevel(), 321, 80);
 	SetPixelMode(app::Pixel::NORMAL);
@@ -644,12 +769,21 @@ bool cApp::DrawStatusBar()
 /// @return 
 bool cApp::DisplayPauseMenu()
 {
-	OnGameUpdate();
-	SetPixelMode(app::Pixel::ALPHA);
-	SetBlendFactor(170.0f / 255.0f);
-	DrawSprite(0, 0, cAssetManager::GetInstance().GetSprite("black_alpha"));
-	SetBlendFactor(255.0f / 255.0f);
-	SetPixelMode(app::Pixel::NORMAL);
+	if (!bPause) { // Pause starts: dim the game frame once and keep it
+		OnGameUpdate();
+		SetPixelMode(app::Pixel::ALPHA);
+		SetBlendFactor(170.0f / 255.0f);
+		DrawSprite(0, 0, cAssetManager::GetInstance().GetSprite("black_alpha"));
+		SetBlendFactor(255.0f / 255.0f);
+		SetPixelMode(app::Pixel::NORMAL);
+		if (!pPauseFrame) {
+			pPauseFrame = std::make_unique<app::Sprite>(ScreenWidth(), ScreenHeight());
+		}
+		CaptureFrame(pPauseFrame.get());
+	}
+	else { // Selection changed: restore the dimmed frame under the pause options
+		DrawSprite(0, 0, pPauseFrame.get());
+	}
 	const std::string pauseOptionName = "pause_" + choices[(pauseOption % 3 + 3) % 3];
 	SetPixelMode(app::Pixel::MASK);
 	DrawSprite(120, 55, cAssetManager::GetInstance().GetSprite(pauseOptionName));
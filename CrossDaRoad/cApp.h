@@ -2,13 +2,17 @@
 #define C_APP_H
 
 #include "cPlayer.h"
+#include "cAnimationClock.h"
 #include "cAssetManager.h"
+#include "cCollisionQuery.h"
 #include "cMapLoader.h"
 #include "cMenu.h"
-#include "cZone.h"
+#include "cSummonScheduler.h"
 #include "gGameEngine.h"
 #include "uAppConst.h"
+#include <array>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,8 +27,16 @@ private: // Interactive Properties (control the map)
 	cPlayer Player;
 
 private: // Reinitializable Properties (depended on each map)
-	cZone Zone;
+	cCollisionQuery Collision;
 	cMapLoader MapLoader;
+	cSummonScheduler Summon;
+
+private: // Animations (advanced on the simulation time, once per tick)
+	cAnimationClock Animation;
+	AnimationId nAboutUsAnimation = -1;
+	AnimationId nScoreBarAnimation = -1;
+	std::array<AnimationId, cMapRuntime::TILE_COUNT> arrTileAnimations; ///< Loop of the animated tiles (key: frame count, -1 if none)
+	std::vector<AnimationId> vecTileAnimations; ///< Loops of the animated tiles of the current map
 
 private: // Customizable Properties (applied to all maps)
 	int nLaneWidth;
@@ -33,16 +45,24 @@ private: // Customizable Properties (applied to all maps)
 	bool wantToExit = true;
 
 private: // Event timers
-	float fTimeSinceStart;
-	float fTimeSinceLastDrawn;
+	float fTimeSinceStart;     ///< Simulation time of the lanes
+	float fTimeSinceLastDrawn; ///< Time of the lanes on screen (interpolated between simulation steps)
+
+private: // Swept collision (last checked lane time and Player position)
+	float fSweepTime = -1.0f;
+	float fSweepPosX = 0.0f;
+	float fSweepPosY = 0.0f;
 
 private: // Special states (applied to freeze frames)
 	bool bPause = false;
 	bool bDeath = false;
+	float fDeathTime = 0.0f; ///< Time since the death, while the death animation plays (in seconds)
+	bool bPixelCollision = false;
 
 private:
 	int pauseOption = 1;
 	std::string choices[3] = { "exit", "resume", "save" };
+	std::unique_ptr<app::Sprite> pPauseFrame; ///< Dimmed game frame under the pause menu (composed when the pause starts)
 
 public: // Constructor & Destructor
 	cApp();
@@ -56,20 +76,24 @@ protected: // Constructor & Destructor Procedure
 	bool GameReset();
 
 protected: // Collision Detection
-	SpriteData GetHitBox(float x, float y) const;
-	SpriteData GetHitBox() const;
+	const MapTile& GetHitBox(float x, float y) const;
+	const MapTile& GetHitBox() const;
 	std::string GetPlayerDeathMessage() const;
 	float GetPlatformVelocity(float fElapsedTime) const;
 
 	bool IsKilled(bool bDebug = false) const;
+	bool IsKilledSinceLastCheck();
 	bool IsPlatformLeft() const;
 	bool IsPlatformRight() const;
 	bool IsPlatformCenter() const;
 	bool IsOnPlatform() const;
 	
 protected: /// Game Updates
+	bool OnLaneUpdate();
 	bool OnPlayerUpdate(float fElapsedTime);
 	bool OnPlayerDeath();
+	bool OnPlayerDeathUpdate(float fElapsedTime);
+	int GetDeathFrame() const;
 	bool OnGameUpdate();
 	bool OnCreateEvent() override;
 	bool OnFixedUpdateEvent(float fTickTime, const engine::Tick& eTickMessage) override;
@@ -81,6 +105,7 @@ protected: /// Game Updates
 	bool OnPauseEvent() override;
 	bool OnDestroyEvent() override;
 	bool OnForceDestroyEvent() override;
+	uint64_t OnStateHashEvent() override;
 
 protected: // File Management
 	std::string SelectTextFilePath(const char* initialDir, const std::string& sDefaultFilePath = "") const;
@@ -88,7 +113,7 @@ protected: // File Management
 
 private: // Game Rendering
 	bool DisplayPauseMenu();
-	bool DrawLane(const cLane& lane, int nRow, int nCol);
+	bool DrawLane(int nRow, int nCol);
 	bool DrawAllLanes();
 	bool DrawBigText(const std::string& sText, int x, int y);
 	bool DrawStatusBar();
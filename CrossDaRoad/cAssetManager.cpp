@@ -1,4 +1,5 @@
 #include "cAssetManager.h"
+#include "gTrace.h"
 
 //////////////////////////////////////////////////////////////////////////
 ////////////////// CONSTRUCTORS and DESTRUCTORS //////////////////////////
@@ -128,7 +129,7 @@ bool cAssetManager::LoadSettingSprites()
 bool cAssetManager::LoadAboutUsSprites()
 {
     bool bSuccess = true;
-    bSuccess &= LoadAnimation("about_us_page", "about_us_page", 4);
+    bSuccess &= LoadAnimation("about_us_page", "about_us_page", app_const::ABOUT_US_FRAMES);
 
     return ReportLoadingResult(bSuccess, "about us");
 }
@@ -168,7 +169,7 @@ bool cAssetManager::LoadFontSprites()
 bool cAssetManager::LoadScoreBarSprites()
 {
     bool bSuccess = true;
-    bSuccess &= LoadAnimation("score_bar", "score_bar", 4);
+    bSuccess &= LoadAnimation("score_bar", "score_bar", app_const::SCORE_BAR_FRAMES);
 
     return ReportLoadingResult(bSuccess, "score bar");
 }
@@ -192,8 +193,8 @@ bool cAssetManager::LoadPlayerIdleSprites()
 bool cAssetManager::LoadPlayerJumpSprites()
 {
     bool bSuccess = true;
-    bSuccess &= LoadAnimation("froggy_jump", "froggy_jump", 6);
-    bSuccess &= LoadAnimation("froggy_jump_left", "froggy_jump_left", 6);
+    bSuccess &= LoadAnimation("froggy_jump", "froggy_jump", app_const::JUMP_FRAMES);
+    bSuccess &= LoadAnimation("froggy_jump_left", "froggy_jump_left", app_const::JUMP_FRAMES);
 
     return ReportLoadingResult(bSuccess, "player jump");
 }
@@ -202,7 +203,7 @@ bool cAssetManager::LoadPlayerJumpSprites()
 bool cAssetManager::LoadPlayerDeathSprites()
 {
     bool bSuccess = true;
-    bSuccess &= LoadAnimation("froggy_death", "froggy_death", 6);
+    bSuccess &= LoadAnimation("froggy_death", "froggy_death", app_const::DEATH_FRAMES);
 
     return ReportLoadingResult(bSuccess, "player death");
 }
@@ -295,6 +296,7 @@ bool cAssetManager::LoadMapOceanSprites()
 /// @return True if loading is successful, false otherwise
 bool cAssetManager::LoadSprite(const std::string& sName, const std::string& sFileName)
 {
+    TRACE_FUNCTION();
     auto* spr = new app::Sprite(GetFileLocation(sFileName));
     if (spr == nullptr || spr->GetData() == nullptr) {
         std::cerr << "cAssetManager::LoadSprite(name=\"" << sName << "\", filename=\"" << sFileName << "\"): ";
@@ -311,6 +313,7 @@ bool cAssetManager::LoadSprite(const std::string& sName, const std::string& sFil
 /// @return True if loading is successful, false otherwise
 bool cAssetManager::LoadAnimation(const std::string& sName, const std::string& sFileName, const int nMaxFrame)
 {
+    TRACE_FUNCTION();
     bool bSuccess = true;
     for (int nFrame = 1; nFrame <= nMaxFrame; ++nFrame) {
         const std::string sFrame = std::to_string(nFrame);
@@ -322,6 +325,7 @@ bool cAssetManager::LoadAnimation(const std::string& sName, const std::string& s
 /// @return True if loading is successful, false otherwise
 bool cAssetManager::LoadAllSprites()
 {
+    TRACE_FUNCTION();
     SetDirectoryPath("./data/assets");
     SetFileExtension("png");
 
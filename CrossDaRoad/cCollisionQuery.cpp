@@ -0,0 +1,546 @@
+#include "cCollisionQuery.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file cCollisionQuery.cpp
+ *
+ * @brief Contains collision query class implementation
+ *
+ * This file implements collision query class. A query maps a pixel to its lane (row), then to the drawn
+ * cell using the same scrolling as cApp::DrawLane, then reads the tile flags. Pixels that were not
+ * covered by a drawn cell are neither dangerous nor blocked.
+**/
+
+/// @brief Integer division rounding toward negative infinity (cells left of the screen have negative index)
+static int FloorDiv(const int nValue, const int nDivisor)
+{
+	return nValue >= 0 ? nValue / nDivisor : -((-nValue + nDivisor - 1) / nDivisor);
+}
+/// @brief Modulo with a result in [0, nDivisor)
+static int64_t FloorMod(const int64_t nValue, const int64_t nDivisor)
+{
+	const int64_t nMod = nValue % nDivisor;
+	return nMod < 0 ? nMod + nDivisor : nMod;
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////// CONSTRUCTORS AND DESTRUCTOR /////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Default constructor
+cCollisionQuery::cCollisionQuery()
+{
+	pRuntime = nullptr;
+	fDrawnTime = 0;
+	nZoneWidth = 0;
+	nZoneHeight = 0;
+	nCellSize = 1;
+	nVisibleCells = 0;
+	nFirstCol = 0;
+	arrDrawnFrames.fill(0);
+}
+
+////////////////////////////////////////////////////////////////////////
+/////////////////// CONSTRUCTOR FUNCTIONS //////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Set up the queried area, nothing is dangerous or blocked until the next update
+/// @param nWidth width of the queried area (in pixels)
+/// @param nHeight height of the queried area (in pixels)
+/// @param nCellSize size of a cell (in pixels)
+/// @param nVisibleCells index of the last cell drawn per lane
+/// @param nFirstCol screen column of the first drawn cell
+void cCollisionQuery::Create(const int nWidth, const int nHeight, const int nCellSize, const int nVisibleCells, const int nFirstCol)
+{
+	pRuntime = nullptr;
+	fDrawnTime = 0;
+	nZoneWidth = nWidth;
+	nZoneHeight = nHeight;
+	this->nCellSize = nCellSize > 0 ? nCellSize : 1;
+	this->nVisibleCells = nVisibleCells;
+	this->nFirstCol = nFirstCol;
+	arrDrawnFrames.fill(0);
+}
+/// @brief Record that the lanes of a map were drawn at a time
+/// @param runtime map that was drawn (must outlive the queries, until the next Create)
+/// @param fTime time used to scroll the lanes when drawing
+void cCollisionQuery::Update(const cMapRuntime& runtime, const float fTime)
+{
+	pRuntime = &runtime;
+	fDrawnTime = fTime;
+}
+/// @brief Record the animation frame drawn for animated tiles
+/// @param nFrameCount number of frames of the animated tiles
+/// @param nFrame frame ID drawn (0 if nothing is drawn)
+void cCollisionQuery::SetDrawnFrame(const int nFrameCount, const int nFrame)
+{
+	if (0 <= nFrameCount && nFrameCount < static_cast<int>(arrDrawnFrames.size())) {
+		arrDrawnFrames[nFrameCount] = static_cast<uint8_t>(nFrame);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////// TILE GETTERS ////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Get the ID of the tile drawn at a pixel
+/// @param nPosX x coordinate (in pixels)
+/// @param nPosY y coordinate (in pixels)
+/// @return tile ID (encode byte) drawn at (nPosX, nPosY), -1 if no tile was drawn there
+int cCollisionQuery::GetTileIdAtPixel(const int nPosX, const int nPosY) const
+{
+	if (pRuntime == nullptr || nPosX < 0 || nPosX >= nZoneWidth || nPosY < 0 || nPosY >= nZoneHeight) {
+		return -1;
+	}
+	const int nRow = nPosY / nCellSize;
+	if (!pRuntime->IsLaneInside(nRow)) {
+		return -1;
+	}
+
+	// Cell k of the lane covers pixels [(nFirstCol + k) * size - offset, (nFirstCol + k + 1) * size - offset)
+	const int nCell = FloorDiv(nPosX + pRuntime->GetLaneScrollOffset(nRow, fDrawnTime, nCellSize), nCellSize) - nFirstCol;
+	if (nCell < 0 || nCell > nVisibleCells) {
+		return -1;
+	}
+	const int nStartPos = pRuntime->GetLaneScrollTile(nRow, fDrawnTime);
+	return pRuntime->GetLaneTile(nRow, nStartPos + nCell);
+}
+/// @brief Get the tile drawn at a pixel
+/// @param nPosX x coordinate (in pixels)
+/// @param nPosY y coordinate (in pixels)
+/// @return tile drawn at (nPosX, nPosY), nullptr if no tile was drawn there
+const MapTile* cCollisionQuery::GetTileAtPixel(const int nPosX, const int nPosY) const
+{
+	const int nTile = GetTileIdAtPixel(nPosX, nPosY);
+	return nTile < 0 ? nullptr : &pRuntime->GetTile(static_cast<uint8_t>(nTile));
+}
+
+////////////////////////////////////////////////////////////////////////
+//////////////////////// DANGER ZONE CHECKERS //////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if pixel at (x, y) is danger
+/// @param x x coordinate
+/// @param y y coordinate
+/// @return true if pixel at (x, y) is danger, false otherwise
+bool cCollisionQuery::IsDangerPixel(const float x, const float y) const
+{
+	const int nTile = GetTileIdAtPixel(static_cast<int>(x), static_cast<int>(y));
+	return nTile >= 0 && pRuntime->HasTileFlag(static_cast<uint8_t>(nTile), MapTile::DANGER);
+}
+
+/// @brief Check if pixel at (x, y) is danger (top left) 
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if top left pixel at (x, y) is danger, false otherwise
+bool cCollisionQuery::IsDangerTopLeft(const float x, const float y, const int size) const
+{
+	return IsDangerPixel(x * static_cast<float>(size) + 1, y * static_cast<float>(size) + 1);
+}
+
+/// @brief Check if pixel at (x, y) is danger (top right) 
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if top right pixel at (x, y) is danger, false otherwise
+bool cCollisionQuery::IsDangerTopRight(const float x, const float y, const int size) const
+{
+	return IsDangerPixel((x + 1) * static_cast<float>(size) - 1, y * static_cast<float>(size) + 1);
+}
+
+/// @brief Check if pixel at (x, y) is danger (bottom left)
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if bottom left pixel at (x, y) is danger, false otherwise
+bool cCollisionQuery::IsDangerBottomLeft(const float x, const float y, const int size) const
+{
+	return IsDangerPixel(x * static_cast<float>(size) + 1, (y + 1) * static_cast<float>(size) - 1);
+}
+
+/// @brief Check if pixel at (x, y) is danger (bottom right)
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if bottom right pixel at (x, y) is danger, false otherwise
+bool cCollisionQuery::IsDangerBottomRight(const float x, const float y, const int size) const
+{
+	return IsDangerPixel((x + 1) * static_cast<float>(size) - 1, (y + 1) * static_cast<float>(size) - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////// SWEPT CHECKERS //////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Find the first time a danger tile touches a moving cell during a time step
+/// @param xFrom x coordinate of the cell at the start of the step (in cells), tested on the same corner pixels as IsDanger*
+/// @param yFrom y coordinate of the cell at the start of the step (in cells)
+/// @param xTo x coordinate of the cell at the end of the step (in cells)
+/// @param yTo y coordinate of the cell at the end of the step (in cells)
+/// @param size size of a cell (in pixels)
+/// @param fTimeFrom start of the time step (lane time, in seconds)
+/// @param fTimeTo end of the time step (lane time, in seconds)
+/// @param fContactTime earliest contact time in [fTimeFrom, fTimeTo] (written only if touched)
+/// @return true if a danger tile touched the cell during the time step, false otherwise
+bool cCollisionQuery::SweepDanger(const float xFrom, const float yFrom, const float xTo, const float yTo, const int size,
+								  const float fTimeFrom, const float fTimeTo, float& fContactTime) const
+{
+	// Corner pixels tested by IsDanger*, a 16-pixel tile touches one of them iff it overlaps the box they span
+	const auto GetCornerBox = [size](const float x, const float y) {
+		const float fSize = static_cast<float>(size);
+		return PixelBox{ static_cast<int>(x * fSize + 1), static_cast<int>(y * fSize + 1),
+						 static_cast<int>((x + 1) * fSize - 1), static_cast<int>((y + 1) * fSize - 1) };
+	};
+	return SweepBox(nullptr, GetCornerBox(xFrom, yFrom), GetCornerBox(xTo, yTo), fTimeFrom, fTimeTo, fContactTime);
+}
+
+/// @brief Find the first time an opacity mask moving during a time step touches the opaque pixels of a danger tile
+/// @param mask opacity mask (e.g. current player frame)
+/// @param nPosXFrom x coordinate of the mask at the start of the step (in pixels)
+/// @param nPosYFrom y coordinate of the mask at the start of the step (in pixels)
+/// @param nPosXTo x coordinate of the mask at the end of the step (in pixels)
+/// @param nPosYTo y coordinate of the mask at the end of the step (in pixels)
+/// @param fTimeFrom start of the time step (lane time, in seconds)
+/// @param fTimeTo end of the time step (lane time, in seconds)
+/// @param fContactTime earliest contact time in [fTimeFrom, fTimeTo] (written only if touched)
+/// @return true if an opaque pixel of mask touched an opaque pixel of a danger tile during the time step, false otherwise
+bool cCollisionQuery::SweepDangerMask(const app::SpriteMask& mask, const int nPosXFrom, const int nPosYFrom, const int nPosXTo, const int nPosYTo,
+									  const float fTimeFrom, const float fTimeTo, float& fContactTime) const
+{
+	if (mask.Width() <= 0 || mask.Height() <= 0) {
+		return false;
+	}
+	const PixelBox boxFrom{ nPosXFrom, nPosYFrom, nPosXFrom + mask.Width() - 1, nPosYFrom + mask.Height() - 1 };
+	const PixelBox boxTo{ nPosXTo, nPosYTo, nPosXTo + mask.Width() - 1, nPosYTo + mask.Height() - 1 };
+	return SweepBox(&mask, boxFrom, boxTo, fTimeFrom, fTimeTo, fContactTime);
+}
+
+/// @brief Find the first time a danger tile touches a box moving linearly from boxFrom to boxTo during a time step
+/// @param pMask opacity mask at the top left corner of the box (nullptr to test the whole box)
+/// @param boxFrom box at the start of the step (in pixels, same size as boxTo)
+/// @param boxTo box at the end of the step (in pixels)
+/// @param fTimeFrom start of the time step (lane time, in seconds)
+/// @param fTimeTo end of the time step (lane time, in seconds)
+/// @param fContactTime earliest contact time in [fTimeFrom, fTimeTo] (written only if touched)
+/// @return true if a danger tile touched the box during the time step, false otherwise
+bool cCollisionQuery::SweepBox(const app::SpriteMask* pMask, const PixelBox& boxFrom, const PixelBox& boxTo,
+							   const float fTimeFrom, const float fTimeTo, float& fContactTime) const
+{
+	if (pRuntime == nullptr || fTimeTo < fTimeFrom) {
+		return false;
+	}
+	// Area covered by the box during the step: tiles that never overlap it cannot touch the box
+	const int nLeft = std::min(boxFrom.nLeft, boxTo.nLeft);
+	const int nRight = std::max(boxFrom.nRight, boxTo.nRight);
+	const int nTop = std::min(boxFrom.nTop, boxTo.nTop);
+	const int nBottom = std::max(boxFrom.nBottom, boxTo.nBottom);
+	if (nRight < 0 || nLeft >= nZoneWidth || nBottom < 0 || nTop >= nZoneHeight) {
+		return false;
+	}
+
+	const int nBoxMoveX = std::abs(boxTo.nLeft - boxFrom.nLeft);
+	const int nBoxMoveY = std::abs(boxTo.nTop - boxFrom.nTop);
+
+	const int nLaneWidth = pRuntime->GetLaneWidth();
+	const int64_t nPeriod = static_cast<int64_t>(nLaneWidth) * nCellSize;
+	const int64_t nSpan = static_cast<int64_t>(nRight - nLeft) + nCellSize;
+	bool isTouched = false;
+	float fFirstTime = fTimeTo;
+	const int nTopRow = FloorDiv(std::max(nTop, 0), nCellSize);
+	const int nBottomRow = FloorDiv(std::min(nBottom, nZoneHeight - 1), nCellSize);
+	for (int nRow = nTopRow; nRow <= nBottomRow; nRow++) {
+		const uint8_t* pLaneTiles = pRuntime->GetLaneTiles(nRow);
+		if (pLaneTiles == nullptr) {
+			continue;
+		}
+		// Scroll distance is monotonic in time, so the step sweeps every integer distance between its ends.
+		// Working on distances (not on sampled positions) gives the same contacts for any split of the step.
+		const float fVelocity = pRuntime->GetLaneVelocity(nRow);
+		const int64_t nSign = fVelocity < 0 ? -1 : 1;
+		const int64_t nFrom = nSign * pRuntime->GetLaneScroll(nRow, fTimeFrom, nCellSize);
+		const int64_t nTo = nSign * pRuntime->GetLaneScroll(nRow, fTimeTo, nCellSize);
+		const float fSpeed = std::fabs(fVelocity) * static_cast<float>(nCellSize);
+		const int nRowY = nRow * nCellSize;
+		const int64_t nSamples = std::max({ std::abs(nTo - nFrom), static_cast<int64_t>(nBoxMoveX), static_cast<int64_t>(nBoxMoveY) });
+
+		for (int nTile = 0; nTile < nLaneWidth; nTile++) {
+			if (!pRuntime->HasTileFlag(pLaneTiles[nTile], MapTile::DANGER)) {
+				continue;
+			}
+			const app::SpriteMask* pTileMask = nullptr;
+			if (pMask != nullptr) {
+				const MapTile& tile = pRuntime->GetTile(pLaneTiles[nTile]);
+				pTileMask = &pRuntime->GetTileMask(tile, arrDrawnFrames[tile.uFrameCount]);
+			}
+			// Tile is drawn at (nFirstCol + nTile) * size - scroll, it overlaps [nLeft, nRight] for nSpan scrolls
+			const int64_t nTileX = static_cast<int64_t>(nFirstCol + nTile) * nCellSize;
+			const int64_t nContactLow = nSign > 0 ? nTileX - nRight : nLeft - nCellSize + 1 - nTileX;
+			const int64_t nPhase = FloorMod(nFrom - nContactLow, nPeriod);
+			const int64_t nContact = nPhase < nSpan ? nFrom : nFrom + (nPeriod - nPhase);
+			if (nContact > nTo) {
+				continue;
+			}
+			// Step is split so that neither the tile nor the box moves more than a pixel between two samples
+			for (int64_t nSample = 0; nSample <= nSamples; nSample++) {
+				const float fFraction = nSamples == 0 ? 1.0f : static_cast<float>(nSample) / static_cast<float>(nSamples);
+				const int64_t nDistance = nFrom + static_cast<int64_t>(std::llround(fFraction * static_cast<float>(nTo - nFrom)));
+				const int64_t nDistancePhase = FloorMod(nDistance - nContactLow, nPeriod);
+				if (nDistancePhase >= nSpan) {
+					continue;
+				}
+				// Tile enters the area on the side it scrolls from: right edge if it moves left, left edge otherwise
+				const int nPhaseX = static_cast<int>(nDistancePhase);
+				const int nTileDrawX = nSign > 0 ? nRight - nPhaseX : nLeft - nCellSize + 1 + nPhaseX;
+				const int nBoxX = boxFrom.nLeft + static_cast<int>(std::lround(fFraction * static_cast<float>(boxTo.nLeft - boxFrom.nLeft)));
+				const int nBoxY = boxFrom.nTop + static_cast<int>(std::lround(fFraction * static_cast<float>(boxTo.nTop - boxFrom.nTop)));
+				bool isTileTouched = false;
+				if (pMask != nullptr) {
+					isTileTouched = pMask->Overlaps(nBoxX, nBoxY, *pTileMask, nTileDrawX, nRowY);
+				}
+				else {
+					const int nBoxRight = nBoxX + (boxFrom.nRight - boxFrom.nLeft);
+					const int nBoxBottom = nBoxY + (boxFrom.nBottom - boxFrom.nTop);
+					isTileTouched = nTileDrawX <= nBoxRight && nBoxX < nTileDrawX + nCellSize
+						&& nRowY <= nBoxBottom && nBoxY < nRowY + nCellSize;
+				}
+				if (isTileTouched) {
+					const float fTime = (nDistance == nFrom || fSpeed == 0) ? fTimeFrom : static_cast<float>(nDistance) / fSpeed;
+					if (!isTouched || fTime < fFirstTime) {
+						fFirstTime = std::max(fTime, fTimeFrom);
+					}
+					isTouched = true;
+					break;
+				}
+			}
+		}
+	}
+	if (isTouched) {
+		fContactTime = fFirstTime;
+	}
+	return isTouched;
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////// PIXEL-PERFECT CHECKERS //////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if an opacity mask touches the opaque pixels of a drawn danger tile
+/// @param mask opacity mask (e.g. current player frame)
+/// @param nPosX x coordinate of the mask (in pixels)
+/// @param nPosY y coordinate of the mask (in pixels)
+/// @return true if an opaque pixel of mask overlaps an opaque pixel of a danger tile, false otherwise
+bool cCollisionQuery::IsDangerMask(const app::SpriteMask& mask, const int nPosX, const int nPosY) const
+{
+	if (pRuntime == nullptr || mask.Width() <= 0 || mask.Height() <= 0) {
+		return false;
+	}
+	const int nTopRow = std::max(FloorDiv(nPosY, nCellSize), 0);
+	const int nBottomRow = std::min(FloorDiv(nPosY + mask.Height() - 1, nCellSize), pRuntime->GetLaneCount() - 1);
+	for (int nRow = nTopRow; nRow <= nBottomRow; nRow++) {
+		const int nCellOffset = pRuntime->GetLaneScrollOffset(nRow, fDrawnTime, nCellSize);
+		const int nStartPos = pRuntime->GetLaneScrollTile(nRow, fDrawnTime);
+		const int nFirstCell = std::max(FloorDiv(nPosX + nCellOffset, nCellSize) - nFirstCol, 0);
+		const int nLastCell = std::min(FloorDiv(nPosX + mask.Width() - 1 + nCellOffset, nCellSize) - nFirstCol, nVisibleCells);
+		for (int nCell = nFirstCell; nCell <= nLastCell; nCell++) {
+			const uint8_t uTile = pRuntime->GetLaneTile(nRow, nStartPos + nCell);
+			if (!pRuntime->HasTileFlag(uTile, MapTile::DANGER)) {
+				continue;
+			}
+			const MapTile& tile = pRuntime->GetTile(uTile);
+			const app::SpriteMask& tileMask = pRuntime->GetTileMask(tile, arrDrawnFrames[tile.uFrameCount]);
+			const int nCellX = (nFirstCol + nCell) * nCellSize - nCellOffset;
+			if (mask.Overlaps(nPosX, nPosY, tileMask, nCellX, nRow * nCellSize)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////
+//////////////////////// BLOCK ZONE CHECKERS ///////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if pixel at (x, y) is block
+/// @param x x coordinate
+/// @param y y coordinate
+/// @return true if pixel at (x, y) is block, false otherwise
+bool cCollisionQuery::IsBlockedPixel(const float x, const float y) const
+{
+	const int nTile = GetTileIdAtPixel(static_cast<int>(x), static_cast<int>(y));
+	return nTile >= 0 && pRuntime->HasTileFlag(static_cast<uint8_t>(nTile), MapTile::BLOCKED);
+}
+
+/// @brief Check if pixel at (x, y) is block (top left) 
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if top left pixel at (x, y) is block, false otherwise
+bool cCollisionQuery::IsBlockedTopLeft(const float x, const float y, const int size) const
+{
+	return IsBlockedPixel(x * static_cast<float>(size) + 1, y * static_cast<float>(size) + 1);
+}
+
+/// @brief Check if pixel at (x, y) is block (top right)
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if top right pixel at (x, y) is block, false otherwise
+bool cCollisionQuery::IsBlockedTopRight(const float x, const float y, const int size) const
+{
+	return IsBlockedPixel((x + 1) * static_cast<float>(size) - 1, y * static_cast<float>(size) + 1);
+}
+
+/// @brief Check if pixel at (x, y) is block (bottom left)
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if bottom left pixel at (x, y) is block, false otherwise
+bool cCollisionQuery::IsBlockedBottomLeft(const float x, const float y, const int size) const
+{
+	return IsBlockedPixel(x * static_cast<float>(size) + 1, (y + 1) * static_cast<float>(size) - 1);
+}
+
+/// @brief Check if pixel at (x, y) is block (bottom right)
+/// @param x x coordinate
+/// @param y y coordinate
+/// @param size size of the pixel
+/// @return true if bottom right pixel at (x, y) is block, false otherwise
+bool cCollisionQuery::IsBlockedBottomRight(const float x, const float y, const int size) const
+{
+	return IsBlockedPixel((x + 1) * static_cast<float>(size) - 1, (y + 1) * static_cast<float>(size) - 1);
+}
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////// MOVEMENT QUERIES ////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/// @brief Find how far a cell moving along x is from the blocked tile just ahead of its leading corners
+/// @param x x coordinate of the cell (in cells), tested on the same corner pixels as IsBlocked*
+/// @param y y coordinate of the cell (in cells)
+/// @param size size of a cell (in pixels)
+/// @param nDirection +1 to move right, -1 to move left
+/// @return distance (in pixels) the cell moves before its leading corners reach the next tile if it is
+/// blocked, -1 otherwise (a move of at most one cell can only enter the next tile)
+float cCollisionQuery::GetBlockDistanceX(const float x, const float y, const int size, const int nDirection) const
+{
+	if (pRuntime == nullptr || nDirection == 0) {
+		return -1;
+	}
+	const float fLead = nDirection > 0 ? (x + 1) * static_cast<float>(size) - 1 : x * static_cast<float>(size) + 1;
+	const int nLead = static_cast<int>(fLead);
+	const int arrPosY[2] = { static_cast<int>(y * static_cast<float>(size) + 1), static_cast<int>((y + 1) * static_cast<float>(size) - 1) };
+	int nDistance = -1;
+	for (const int nPosY : arrPosY) {
+		const int nEdge = GetTileEdgeDistanceX(nLead, nPosY, nDirection);
+		if (IsBlockedPixel(static_cast<float>(nLead + nDirection * nEdge), static_cast<float>(nPosY)) && (nDistance < 0 || nEdge < nDistance)) {
+			nDistance = nEdge;
+		}
+	}
+	return nDistance < 0 ? -1 : GetLeadDistance(fLead, nLead, nDistance, nDirection);
+}
+
+/// @brief Find how far a cell moving along y is from the blocked tiles of the lane just ahead of its leading corners
+/// @param x x coordinate of the cell (in cells), tested on the same corner pixels as IsBlocked*
+/// @param y y coordinate of the cell (in cells)
+/// @param size size of a cell (in pixels)
+/// @param nDirection +1 to move down, -1 to move up
+/// @return distance (in pixels) the cell moves before its leading corners reach the next lane if a corner
+/// would enter a blocked tile there, -1 otherwise
+float cCollisionQuery::GetBlockDistanceY(const float x, const float y, const int size, const int nDirection) const
+{
+	if (pRuntime == nullptr || nDirection == 0) {
+		return -1;
+	}
+	const float fLead = nDirection > 0 ? (y + 1) * static_cast<float>(size) - 1 : y * static_cast<float>(size) + 1;
+	const int nLead = static_cast<int>(fLead);
+	const int nEdge = GetTileEdgeDistanceY(nLead, nDirection);
+	const int arrPosX[2] = { static_cast<int>(x * static_cast<float>(size) + 1), static_cast<int>((x + 1) * static_cast<float>(size) - 1) };
+	for (const int nPosX : arrPosX) {
+		if (IsBlockedPixel(static_cast<float>(nPosX), static_cast<float>(nLead + nDirection * nEdge))) {
+			return GetLeadDistance(fLead, nLead, nEdge, nDirection);
+		}
+	}
+	return -1;
+}
+
+/// @brief Find the nearest offset along x where no corner pixel of a cell is on a danger tile
+/// @param x x coordinate of the cell (in cells), tested on the same corner pixels as IsDanger*
+/// @param y y coordinate of the cell (in cells)
+/// @param size size of a cell (in pixels)
+/// @param nDirection +1 to search right, -1 to search left
+/// @param nMaxOffset largest offset to search (in pixels)
+/// @param nOffset nearest safe offset in [1, nMaxOffset] (in pixels, written only if found)
+/// @return true if a safe offset was found, false otherwise
+bool cCollisionQuery::FindSafeOffsetX(const float x, const float y, const int size, const int nDirection, const int nMaxOffset, int& nOffset) const
+{
+	if (pRuntime == nullptr || nDirection == 0) {
+		return false;
+	}
+	const int arrPosX[2] = { static_cast<int>(x * static_cast<float>(size) + 1), static_cast<int>((x + 1) * static_cast<float>(size) - 1) };
+	const int arrPosY[2] = { static_cast<int>(y * static_cast<float>(size) + 1), static_cast<int>((y + 1) * static_cast<float>(size) - 1) };
+	// A corner only changes tile at a tile edge, so only the first offset past each edge is tested
+	int nCandidate = 1;
+	while (nCandidate <= nMaxOffset) {
+		bool isSafe = true;
+		int nNext = nMaxOffset + 1;
+		for (const int nPosY : arrPosY) {
+			for (const int nPosX : arrPosX) {
+				const int nPixelX = nPosX + nDirection * nCandidate;
+				isSafe = isSafe && !IsDangerPixel(static_cast<float>(nPixelX), static_cast<float>(nPosY));
+				nNext = std::min(nNext, nCandidate + GetTileEdgeDistanceX(nPixelX, nPosY, nDirection));
+			}
+		}
+		if (isSafe) {
+			nOffset = nCandidate;
+			return true;
+		}
+		nCandidate = nNext;
+	}
+	return false;
+}
+
+/// @brief Distance a leading corner moves before its pixel reaches a pixel ahead
+/// @param fLead coordinate of the leading corner (in pixels)
+/// @param nLead pixel of the leading corner
+/// @param nPixels distance from the leading corner pixel to the pixel ahead (in pixels)
+/// @param nDirection +1 if the pixel ahead is after the corner, -1 if it is before
+/// @return distance to move (in pixels), the corner is on the pixel ahead once moved by at least that much
+float cCollisionQuery::GetLeadDistance(const float fLead, const int nLead, const int nPixels, const int nDirection)
+{
+	const float fFraction = fLead - static_cast<float>(nLead);
+	return nDirection > 0 ? static_cast<float>(nPixels) - fFraction : static_cast<float>(nPixels - 1) + fFraction;
+}
+
+/// @brief Distance from a pixel to the next pixel along x that may be drawn from another tile
+/// @param nPosX x coordinate (in pixels)
+/// @param nPosY y coordinate (in pixels), selects the lane and its scrolling
+/// @param nDirection +1 for the next edge on the right, -1 on the left
+/// @return distance to the first pixel past the edge (in pixels, at least 1)
+int cCollisionQuery::GetTileEdgeDistanceX(const int nPosX, const int nPosY, const int nDirection) const
+{
+	const int nRow = FloorDiv(nPosY, nCellSize);
+	const int nCellOffset = pRuntime->IsLaneInside(nRow) ? pRuntime->GetLaneScrollOffset(nRow, fDrawnTime, nCellSize) : 0;
+	const int nCell = FloorDiv(nPosX + nCellOffset, nCellSize);
+	int nDistance = nDirection > 0 ? (nCell + 1) * nCellSize - nCellOffset - nPosX : nPosX - (nCell * nCellSize - nCellOffset - 1);
+	// Pixels outside the queried area are never dangerous nor blocked
+	if (nDirection > 0 && nPosX < nZoneWidth) {
+		nDistance = std::min(nDistance, nZoneWidth - nPosX);
+	}
+	else if (nDirection < 0 && nPosX >= 0) {
+		nDistance = std::min(nDistance, nPosX + 1);
+	}
+	return nDistance;
+}
+
+/// @brief Distance from a pixel to the first pixel of the next lane along y
+/// @param nPosY y coordinate (in pixels)
+/// @param nDirection +1 for the lane below, -1 for the lane above
+/// @return distance to the first pixel of the next lane (in pixels, at least 1)
+int cCollisionQuery::GetTileEdgeDistanceY(const int nPosY, const int nDirection) const
+{
+	const int nRow = FloorDiv(nPosY, nCellSize);
+	return nDirection > 0 ? (nRow + 1) * nCellSize - nPosY : nPosY - (nRow * nCellSize - 1);
+}
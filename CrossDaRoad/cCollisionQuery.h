@@ -0,0 +1,92 @@
+#ifndef C_COLLISION_QUERY_H
+#define C_COLLISION_QUERY_H
+
+#include "cMapRuntime.h"
+#include "gSpriteMask.h"
+#include <array>
+
+/**
+ * @file cCollisionQuery.h
+ *
+ * @brief Contains collision query class
+ *
+ * This file contains collision query class that answers danger and block queries at any screen point
+ * directly from lane index, lane velocity and time, without per-pixel buffers. Movement queries (how far
+ * a cell can move before a blocked tile, nearest safe offset) jump from tile edge to tile edge instead of
+ * testing each pixel of the way.
+**/
+
+/// @brief Class for collision detection against the lanes as they were last drawn
+class cCollisionQuery
+{
+private:
+	/// @brief Pixel box with inclusive bounds
+	struct PixelBox
+	{
+		int nLeft;   ///< Leftmost pixel
+		int nTop;    ///< Topmost pixel
+		int nRight;  ///< Rightmost pixel
+		int nBottom; ///< Bottommost pixel
+	};
+
+private:
+	const cMapRuntime* pRuntime; ///< Map being queried (nullptr until the lanes are drawn)
+	float fDrawnTime;            ///< Time at which the lanes were last drawn
+	int nZoneWidth;              ///< Width of the queried area (in pixels)
+	int nZoneHeight;             ///< Height of the queried area (in pixels)
+	int nCellSize;               ///< Size of a cell (in pixels)
+	int nVisibleCells;           ///< Index of the last cell drawn per lane (cells 0..nVisibleCells are drawn)
+	int nFirstCol;               ///< Screen column of the first drawn cell
+	std::array<uint8_t, 256> arrDrawnFrames; ///< Animation frame drawn for tiles with N frames (key: N)
+
+public: // Constructors & Destructor
+	cCollisionQuery();
+	~cCollisionQuery() = default;
+
+public: // Constructor functions
+	void Create(int nWidth, int nHeight, int nCellSize, int nVisibleCells, int nFirstCol = -1);
+	void Update(const cMapRuntime& runtime, float fTime);
+	void SetDrawnFrame(int nFrameCount, int nFrame);
+
+public: // Tile Getters
+	int GetTileIdAtPixel(int nPosX, int nPosY) const;
+	const MapTile* GetTileAtPixel(int nPosX, int nPosY) const;
+
+public: // Danger Zone Checkers
+	bool IsDangerPixel(float x, float y) const;
+
+	bool IsDangerTopLeft(float x, float y, int size) const;
+	bool IsDangerTopRight(float x, float y, int size) const;
+	bool IsDangerBottomLeft(float x, float y, int size) const;
+	bool IsDangerBottomRight(float x, float y, int size) const;
+
+public: // Swept Checkers
+	bool SweepDanger(float xFrom, float yFrom, float xTo, float yTo, int size, float fTimeFrom, float fTimeTo, float& fContactTime) const;
+	bool SweepDangerMask(const app::SpriteMask& mask, int nPosXFrom, int nPosYFrom, int nPosXTo, int nPosYTo,
+						 float fTimeFrom, float fTimeTo, float& fContactTime) const;
+
+public: // Pixel-perfect Checkers
+	bool IsDangerMask(const app::SpriteMask& mask, int nPosX, int nPosY) const;
+
+public: // Block Zone Checkers
+	bool IsBlockedPixel(float x, float y) const;
+
+	bool IsBlockedTopLeft(float x, float y, int size) const;
+	bool IsBlockedTopRight(float x, float y, int size) const;
+	bool IsBlockedBottomLeft(float x, float y, int size) const;
+	bool IsBlockedBottomRight(float x, float y, int size) const;
+
+public: // Movement Queries
+	float GetBlockDistanceX(float x, float y, int size, int nDirection) const;
+	float GetBlockDistanceY(float x, float y, int size, int nDirection) const;
+	bool FindSafeOffsetX(float x, float y, int size, int nDirection, int nMaxOffset, int& nOffset) const;
+
+private:
+	int GetTileEdgeDistanceX(int nPosX, int nPosY, int nDirection) const;
+	int GetTileEdgeDistanceY(int nPosY, int nDirection) const;
+	bool SweepBox(const app::SpriteMask* pMask, const PixelBox& boxFrom, const PixelBox& boxTo,
+				  float fTimeFrom, float fTimeTo, float& fContactTime) const;
+	static float GetLeadDistance(float fLead, int nLead, int nPixels, int nDirection);
+};
+
+#endif // C_COLLISION_QUERY_H
@@ -1,6 +1,9 @@
 #include "cMapLoader.h"
+#include "gTrace.h"
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <charconv>
 
 /**
  * @file cMapLoader.cpp
@@ -10,6 +13,84 @@
  * This file implements SpriteData struct, cLane class, and cMapLoader class for map loading and manipulation in game.
 **/
 
+// ==================================================================================================
+// ===================================== MapDiagnostic ==============================================
+// ==================================================================================================
+
+/// @brief Getter for diagnostic in string ("error at line 3, column 12: message")
+std::string MapDiagnostic::Show() const
+{
+	std::string sResult = eSeverity == MAP_ERROR ? "error" : "warning";
+	if (nLine > 0) {
+		sResult += " at line " + std::to_string(nLine) + ", column " + std::to_string(nColumn);
+	}
+	return sResult + ": " + sMessage;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// PARSING HELPERS ///////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if a character separates tokens in map files
+static bool IsBlank(const char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+/// @brief Remove separating characters at both ends of a view
+static std::string_view TrimBlank(std::string_view sView)
+{
+	while (!sView.empty() && IsBlank(sView.front())) {
+		sView.remove_prefix(1);
+	}
+	while (!sView.empty() && IsBlank(sView.back())) {
+		sView.remove_suffix(1);
+	}
+	return sView;
+}
+/// @brief Extract the next token of a view and advance the view past it
+/// @param sRest View to extract from (modified)
+/// @return Next token, empty if there is none
+static std::string_view NextToken(std::string_view& sRest)
+{
+	size_t nBegin = 0;
+	while (nBegin < sRest.size() && IsBlank(sRest[nBegin])) {
+		nBegin++;
+	}
+	size_t nEnd = nBegin;
+	while (nEnd < sRest.size() && !IsBlank(sRest[nEnd])) {
+		nEnd++;
+	}
+	const std::string_view sToken = sRest.substr(nBegin, nEnd - nBegin);
+	sRest.remove_prefix(nEnd);
+	return sToken;
+}
+/// @brief Get 1-based column of a character pointer inside a line
+static int ColumnOf(const std::string_view sLine, const char* pChar)
+{
+	return static_cast<int>(pChar - sLine.data()) + 1;
+}
+/// @brief Parse a number at the start of a view (leading '+' allowed)
+/// @param sValue View to parse
+/// @param value Parsed number (unchanged if parsing failed)
+/// @return Pointer past the parsed number, nullptr if no number was parsed
+template <typename T>
+static const char* ParseNumber(std::string_view sValue, T& value)
+{
+	if (!sValue.empty() && sValue.front() == '+') {
+		sValue.remove_prefix(1);
+	}
+	const char* pBegin = sValue.data();
+	const char* pEnd = pBegin + sValue.size();
+	std::from_chars_result result;
+	if constexpr (std::is_floating_point_v<T>) {
+		result = std::from_chars(pBegin, pEnd, value, std::chars_format::general);
+	}
+	else {
+		result = std::from_chars(pBegin, pEnd, value);
+	}
+	return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
 // ==================================================================================================
 // ===================================== SpriteData =================================================
 // ==================================================================================================
@@ -99,49 +180,6 @@ void SpriteData::debug(char end) const
 	}
 	std::cerr << "}" << end;
 }
-#include <random>
-#include <iomanip>
-std::default_random_engine generator(std::random_device{}());
-std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
-std::map<int, float> mapLastSummon;
-bool SpriteData::SuccessSummon(int nCol, int nRow, float fCurrentTime, int fps) const
-{
-	if (summon == nullptr || fChance <= 0) {
-		return false; // Summon is not enabled or chance is zero or negative
-	}
-
-	const int id = static_cast<int>(nCol * 1e4 + nRow);
-	if (mapLastSummon.count(id) == false) {
-		std::uniform_real_distribution<float> initialDistribution(fDuration, 2 * fDuration + fCooldown);
-		mapLastSummon[id] = initialDistribution(generator);
-		//std::cerr << "map[" << id << "] = " << fDuration + fCooldown << std::endl;
-	}
-	float& fLastSummon = mapLastSummon[id];
-	const float fDeltaTime = fCurrentTime - fLastSummon;
-
-	//std::cerr << nCol << " " << nRow << " id=" << id << ": ";
-	//std::cerr << "delta=" << fDeltaTime << " current=" << fCurrentTime << " " << "last=" << fLastSummon << " -> ";
-	if (fDeltaTime >= 0) {
-		if (fDeltaTime <= fDuration) {
-			//std::cerr << "Continue" << std::endl;
-			return true;
-		}
-		else if (fDeltaTime < fDuration + fCooldown) {
-			//std::cerr << "Stoped" << std::endl;
-			return false;
-		}
-	}
-
-	const auto fProbability = static_cast<float>(fChance / 100.0 / (fps == 0 ? 1 : fps));
-	const float fGenerated = distribution(generator);
-	if (fGenerated < fProbability) {
-		fLastSummon = fCurrentTime;
-		//std::cerr << "Recreated" << std::endl;
-		return true;
-	}
-	//std::cerr << "Failed" << std::endl;
-	return false; // Summon is not successful
-}
 
 // ==================================================================================================
 // ===================================== cLane ======================================================
@@ -179,7 +217,7 @@ float cLane::GetVelocity() const
 }
 
 /// @brief Getter for character representation of the lane
-std::string cLane::GetLane() const
+const std::string& cLane::GetLane() const
 {
 	return sLane;
 }
@@ -214,6 +252,8 @@ void cLane::SetLane(const std::string& lane)
 cMapLoader::cMapLoader()
 {
 	nMapLevel = app_const::GAME_LEVEL_INIT;
+	pRuntime = std::make_unique<cMapRuntime>();
+	nPrefetchLevel = -1;
 }
 /// @brief Destructor
 cMapLoader::~cMapLoader()
@@ -235,12 +275,12 @@ void cMapLoader::Init()
 /// @brief Destruct properties of map loader
 void cMapLoader::Destruct()
 {
+	CancelPrefetch();
 	mapSprites.clear();
 	vecLanes.clear();
 	vecMapNames.clear();
 	vecMapDescriptions.clear();
-	dangerPattern.clear();
-	blockPattern.clear();
+	pRuntime->Clear();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -252,6 +292,8 @@ void cMapLoader::MapClear()
 {
 	mapSprites.clear();
 	vecLanes.clear();
+	vecDiagnostics.clear();
+	pRuntime->Clear();
 }
 /// @brief Load next map level
 void cMapLoader::NextLevel()
@@ -269,22 +311,6 @@ void cMapLoader::PrevLevel()
 		std::cerr << "Reset to map zero (underflow)" << std::endl;
 	}
 }
-/// @brief Update pattern of danger and block
-void cMapLoader::UpdatePattern()
-{
-	dangerPattern.clear();
-	blockPattern.clear();
-	for (auto [fst, snd] : mapSprites) {
-		auto sprite = snd;
-		if (sprite.isBlocked) {
-			blockPattern += sprite.encode;
-		}
-		if (sprite.isDanger) {
-			dangerPattern += sprite.encode;
-		}
-		sprite.debug();
-	}
-}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////// GETTERS ///////////////////////////////////////////////////////
@@ -301,7 +327,7 @@ int cMapLoader::GetMapCount() const
 	return static_cast<int>(vecMapNames.size());
 }
 /// @brief Getter for lanes of the map
-std::vector<cLane> cMapLoader::GetLanes() const
+const std::vector<cLane>& cMapLoader::GetLanes() const
 {
 	return vecLanes;
 }
@@ -339,50 +365,63 @@ std::string cMapLoader::GetMapDescription() const
 }
 /// @brief Getter for sprite data by graphic
 /// @param graphic Graphic of the sprite
-SpriteData cMapLoader::GetSpriteData(char graphic) const
+const SpriteData& cMapLoader::GetSpriteData(char graphic) const
 {
+	static const SpriteData emptySprite;
 	const auto spriteIter = mapSprites.find(graphic);
 	if (spriteIter != mapSprites.end()) {
 		return spriteIter->second;
 	}
 	else {
-		return SpriteData();
+		return emptySprite;
 	}
 }
-/// @brief Getter for danger pattern
-std::string cMapLoader::GetDangerPattern()
-{
-	return dangerPattern;
-}
-/// @brief Getter for block pattern
-std::string cMapLoader::GetBlockPattern()
+/// @brief Getter for flags of all tiles of the current map (key: encode byte)
+const TileFlagTable& cMapLoader::GetTileFlags() const
 {
-	return blockPattern;
+	return pRuntime->GetTileFlags();
 }
 /// @brief Getter for lane by position
 /// @param fPos Index of the lane in vector
-cLane cMapLoader::GetLane(int fPos) const
+const cLane& cMapLoader::GetLane(int fPos) const
 {
 	return vecLanes[fPos];
 }
 /// @brief Getter for lane by position (floor)
 /// @param fPos Index of the lane in vector
-cLane cMapLoader::GetLaneFloor(float fPos) const
+const cLane& cMapLoader::GetLaneFloor(float fPos) const
 {
 	return GetLane(static_cast<int>(std::floor(fPos)));
 }
 /// @brief Getter for lane by position (round)
 /// @param fPos Index of the lane in vector
-cLane cMapLoader::GetLaneRound(float fPos) const
+const cLane& cMapLoader::GetLaneRound(float fPos) const
 {
 	return GetLane(static_cast<int>(std::round(fPos)));
 }
 /// @brief Getter for lane by position (ceil)
 /// @param fPos Index of the lane in vector
-cLane cMapLoader::GetLaneCeil(float fPos) const
+const cLane& cMapLoader::GetLaneCeil(float fPos) const
 {
 	return GetLane(static_cast<int>(std::ceil(fPos)));
 }
+/// @brief Getter for diagnostics reported while loading the current map
+const std::vector<MapDiagnostic>& cMapLoader::GetDiagnostics() const
+{
+	return vecDiagnostics;
+}
+/// @brief Check if an error was reported while loading the current map
+bool cMapLoader::HasMapError() const
+{
+	return std::any_of(vecDiagnostics.begin(), vecDiagnostics.end(), [](const MapDiagnostic& diagnostic) {
+		return diagnostic.eSeverity == MapDiagnostic::MAP_ERROR;
+		});
+}
+/// @brief Getter for compiled runtime form of the current map
+const cMapRuntime& cMapLoader::GetRuntime() const
+{
+	return *pRuntime;
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////// INFO GETTERS //////////////////////////////////////////////////
@@ -393,6 +432,15 @@ std::string cMapLoader::ShowMapLevel() const
 {
 	return std::to_string(GetMapLevel());
 }
+/// @brief Getter for all diagnostics of the current map in string (one per line)
+std::string cMapLoader::ShowDiagnostics() const
+{
+	std::string sResult;
+	for (const MapDiagnostic& diagnostic : vecDiagnostics) {
+		sResult += GetMapName() + ": " + diagnostic.Show() + "\n";
+	}
+	return sResult;
+}
 /// @brief Getter for map info in string
 std::string cMapLoader::ShowMapInfo() const
 {
@@ -423,143 +471,160 @@ bool cMapLoader::SetMapLevel(int MapLevel)
 	return true;
 }
 
+/// @brief Record a parsing diagnostic of the current map
+/// @param eSeverity Whether the diagnostic is a warning or an error
+/// @param nLine Line number in map file (1-based, 0 if not related to a line)
+/// @param nColumn Column number in map file (1-based)
+/// @param sMessage Description of the problem
+void cMapLoader::Report(const MapDiagnostic::Severity eSeverity, const int nLine, const int nColumn, std::string sMessage)
+{
+	vecDiagnostics.push_back({ eSeverity, nLine, nColumn, std::move(sMessage) });
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////// LOADERS ///////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// @brief Load map lane from file with debug mode (optional)
-/// @param sLine Line of the map lane 
-/// @param bDebug Whether to print debug message or not
+/// @brief Load map lane from a line of map file
+/// @param sLine Line of the map lane (untrimmed)
+/// @param nLine Line number in map file (for diagnostics)
 /// @return True if map lane was loaded successfully, false otherwise
-bool cMapLoader::LoadMapLane(const std::string& sLine, bool bDebug)
+bool cMapLoader::LoadMapLane(const std::string_view sLine, const int nLine)
 {
-	std::cout << sLine << std::endl;
-	const size_t spacePos = sLine.find(' ');
-	if (spacePos == std::string::npos) {
-		std::cout << "Error: Space not found in line: " << sLine << std::endl;
+	std::string_view sRest = sLine;
+	const std::string_view sLane = NextToken(sRest);
+	const std::string_view sVelocity = TrimBlank(sRest);
+	if (sVelocity.empty()) {
+		Report(MapDiagnostic::MAP_ERROR, nLine, ColumnOf(sLine, sLane.data() + sLane.size()), "expected lane velocity after lane");
 		return false;
 	}
 
-	try {
-		const float velocity = std::stof(sLine.substr(spacePos + 1));
-		const std::string laneString = sLine.substr(0, spacePos);
-		const cLane lane(velocity, laneString);
-		vecLanes.push_back(lane);
-		return true;
-	}
-	catch ([[maybe_unused]] const std::invalid_argument& e) {
-		std::cout << "Error: Invalid velocity value in line: " << sLine
-			<< std::endl;
+	float velocity = 0;
+	const char* pEnd = ParseNumber(sVelocity, velocity);
+	if (pEnd == nullptr) {
+		Report(MapDiagnostic::MAP_ERROR, nLine, ColumnOf(sLine, sVelocity.data()), "invalid velocity value");
 		return false;
 	}
-	catch ([[maybe_unused]] const std::out_of_range& e) {
-		std::cout << "Error: Velocity value is out of range in line: " << sLine
-			<< std::endl;
-		return false;
+	if (pEnd != sVelocity.data() + sVelocity.size()) {
+		Report(MapDiagnostic::MAP_WARNING, nLine, ColumnOf(sLine, pEnd), "unexpected characters after velocity");
 	}
+	vecLanes.emplace_back(velocity, std::string(sLane));
+	return true;
 }
-/// @brief Load map sprite from file
-///	@param sLine 
-/// @param bDebug
+/// @brief Load map sprite from a line of map file ("$ c key=value ..." or ": key=value ...")
+///	@param sLine Line of the map sprite (untrimmed)
+/// @param nLine Line number in map file (for diagnostics)
 ///	@return true if map sprite was loaded successfully, false otherwise
-bool cMapLoader::LoadMapSprite(const std::string& sLine, bool bDebug)
+bool cMapLoader::LoadMapSprite(const std::string_view sLine, const int nLine)
 {
-	std::istringstream iss(sLine);
-	char token;
-	iss >> token;
-
-	if (bDebug) {
-		std::cout << "# Current Line = \"" << sLine << "\" -> token=" << token << std::endl;
+	std::string_view sRest = TrimBlank(sLine);
+	if (sRest.empty()) {
+		return false;
 	}
 
+	const char token = sRest.front();
+	sRest.remove_prefix(1);
 	if (token == '$') { // New Sprite
-		currentSprite = SpriteData();
-		iss >> currentSprite.encode;
-		if (bDebug) {
-			std::cerr << "Create new Sprite('" << currentSprite.encode << "')" << std::endl;
+		sRest = TrimBlank(sRest);
+		if (sRest.empty()) {
+			Report(MapDiagnostic::MAP_ERROR, nLine, ColumnOf(sLine, sRest.data()), "expected sprite encode after '$'");
+			return false;
 		}
+		currentSprite = SpriteData();
+		currentSprite.encode = sRest.front();
+		sRest.remove_prefix(1);
+	}
+	else if (token != ':') {
+		Report(MapDiagnostic::MAP_WARNING, nLine, ColumnOf(sLine, sRest.data() - 1), "expected '$' or ':' at start of sprite line");
 	}
-	{ // Continue Loading Last Sprite
-		std::string attribute, value;
-		std::string raw;
-		while (iss >> raw) {
-			// Find the position of '=' in the raw string
-			const size_t equalPos = raw.find('=');
-
-			// Check if the format is correct (contains '=' character)
-			if (equalPos != std::string::npos) {
-				// Split the raw string into attribute and value based on '='
-				attribute = raw.substr(0, equalPos);
-				value = raw.substr(equalPos + 1);
-				if (bDebug) {
-					std::cerr << attribute << " vs " << value << std::endl;
-				}
 
-				if (attribute == "sprite") {
-					currentSprite.sSpriteName = value;
-				}
-				else if (attribute == "background") {
-					currentSprite.sBackgroundName = value;
-				}
-				else if (attribute == "category") {
-					currentSprite.sCategory = value;
-				}
-				else if (attribute == "block") {
-					if (value == "true") {
-						currentSprite.isBlocked = true;
-					}
-					else if (value == "false")
-						currentSprite.isBlocked = false;
-				}
-				else if (attribute == "danger") {
-					if (value == "true") {
-						currentSprite.isDanger = true;
-					}
-					else if (value == "false")
-						currentSprite.isDanger = false;
-				}
-				else if (attribute == "platformspeed") {
-					currentSprite.fPlatform = std::stof(value);
-				}
-				else if (attribute == "spriteX") {
-					currentSprite.nSpritePosX = std::stoi(value);
-				}
-				else if (attribute == "spriteY") {
-					currentSprite.nSpritePosY = std::stoi(value);
-				}
-				else if (attribute == "backgroundX") {
-					currentSprite.nBackgroundPosX = std::stoi(value);
-				}
-				else if (attribute == "backgroundY") {
-					currentSprite.nBackgroundPosY = std::stoi(value);
-				}
-				else if (attribute == "id") {
-					currentSprite.nID = std::stoi(value);
-				}
-				else if (attribute == "summon") {
-					char target = value[0];
-					currentSprite.summon = &mapSprites[target];
-				}
-				else if (attribute == "duration") {
-					currentSprite.fDuration = ExtractTime(value);
-				}
-				else if (attribute == "cooldown") {
-					currentSprite.fCooldown = ExtractTime(value);
-				}
-				else if (attribute == "chance") {
-					value.pop_back();
-					currentSprite.fChance = std::stof(value);
-				}
-				else {
-					std::cerr << "Unknown attribute = \"" << attribute << "\" assigning value \"" << value << "\"";
-					std::cerr << std::endl;
-				}
+	// Continue Loading Last Sprite
+	for (std::string_view sRaw = NextToken(sRest); !sRaw.empty(); sRaw = NextToken(sRest)) {
+		const size_t equalPos = sRaw.find('=');
+		if (equalPos == std::string_view::npos) {
+			Report(MapDiagnostic::MAP_WARNING, nLine, ColumnOf(sLine, sRaw.data()), "expected attribute=value");
+			continue;
+		}
+		const std::string_view attribute = sRaw.substr(0, equalPos);
+		std::string_view value = sRaw.substr(equalPos + 1);
+		const int nColumn = ColumnOf(sLine, value.data());
+
+		auto LoadBool = [&](bool& bTarget) {
+			if (value == "true") {
+				bTarget = true;
+			}
+			else if (value == "false") {
+				bTarget = false;
+			}
+			else {
+				Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "expected true or false");
 			}
-			if (bDebug) {
-				std::cerr << "Assign attribute Sprite['" << currentSprite.encode
-					<< "']";
-				std::cerr << "->" << attribute << " := " << value << std::endl;
+			};
+		auto LoadNumber = [&](auto& target) {
+			const char* pEnd = ParseNumber(value, target);
+			if (pEnd == nullptr) {
+				Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "invalid numeric value");
 			}
+			else if (pEnd != value.data() + value.size()) {
+				Report(MapDiagnostic::MAP_WARNING, nLine, ColumnOf(sLine, pEnd), "unexpected characters after number");
+			}
+			};
+
+		if (attribute == "sprite") {
+			currentSprite.sSpriteName = value;
+		}
+		else if (attribute == "background") {
+			currentSprite.sBackgroundName = value;
+		}
+		else if (attribute == "category") {
+			currentSprite.sCategory = value;
+		}
+		else if (attribute == "block") {
+			LoadBool(currentSprite.isBlocked);
+		}
+		else if (attribute == "danger") {
+			LoadBool(currentSprite.isDanger);
+		}
+		else if (attribute == "platformspeed") {
+			LoadNumber(currentSprite.fPlatform);
+		}
+		else if (attribute == "spriteX") {
+			LoadNumber(currentSprite.nSpritePosX);
+		}
+		else if (attribute == "spriteY") {
+			LoadNumber(currentSprite.nSpritePosY);
+		}
+		else if (attribute == "backgroundX") {
+			LoadNumber(currentSprite.nBackgroundPosX);
+		}
+		else if (attribute == "backgroundY") {
+			LoadNumber(currentSprite.nBackgroundPosY);
+		}
+		else if (attribute == "id") {
+			LoadNumber(currentSprite.nID);
+		}
+		else if (attribute == "summon") {
+			if (value.empty()) {
+				Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "expected sprite encode to summon");
+			}
+			else {
+				currentSprite.summon = &mapSprites[value.front()];
+			}
+		}
+		else if (attribute == "duration") {
+			currentSprite.fDuration = ExtractTime(value, nLine, nColumn);
+		}
+		else if (attribute == "cooldown") {
+			currentSprite.fCooldown = ExtractTime(value, nLine, nColumn);
+		}
+		else if (attribute == "chance") {
+			if (!value.empty() && value.back() == '%') {
+				value.remove_suffix(1);
+			}
+			LoadNumber(currentSprite.fChance);
+		}
+		else {
+			Report(MapDiagnostic::MAP_WARNING, nLine, ColumnOf(sLine, attribute.data()), "unknown attribute \"" + std::string(attribute) + "\"");
 		}
 	}
 	SetSpriteData(currentSprite);
@@ -604,31 +669,27 @@ bool cMapLoader::LoadMapName(const std::string& sFileName)
 	ifs.close();
 	return true;
 }
-/// @brief Load map level, map sprite, and map name from file
-///	@param nMapLevel - Map level
-///	@return true if map level, map sprite, and map name were loaded successfully,
-bool cMapLoader::LoadMapLevel(const int& nMapLevel)
+/// @brief Load map lanes and sprites from a memory buffer in a single pass (no line copies)
+/// @param sBuffer Content of a map file
+/// @return true if no error was reported, false otherwise
+bool cMapLoader::LoadMapBuffer(const std::string_view sBuffer)
 {
-	MapClear();
-	const std::string& sFileName = "data/maps/map" + std::to_string(nMapLevel) + ".txt";
-	std::ifstream ifs(sFileName);
-	if (!ifs.is_open()) {
-		std::cout << "Failed to open file: " << sFileName << std::endl;
-		std::cerr << "Error state: " << ifs.rdstate() << std::endl;
-		std::cout << "Current Working Directory: " << std::filesystem::current_path() << std::endl;
-		const std::string& sFileName = "data/maps/map" + std::to_string(nMapLevel) + ".txt";
-		std::cout << "File Path: " << sFileName << std::endl;
-		return false;
-	}
-
 	bool isLoadingSprite = false;
-	for (std::string sLine; std::getline(ifs, sLine);) {
-		strutil::deduplicate(sLine, " ");
-		strutil::trim(sLine);
-		if (sLine.empty())
+	int nLine = 0;
+	for (size_t nBegin = 0; nBegin < sBuffer.size();) {
+		size_t nEnd = sBuffer.find('\n', nBegin);
+		if (nEnd == std::string_view::npos) {
+			nEnd = sBuffer.size();
+		}
+		const std::string_view sLine = sBuffer.substr(nBegin, nEnd - nBegin);
+		nBegin = nEnd + 1;
+		nLine++;
+
+		const std::string_view sContent = TrimBlank(sLine);
+		if (sContent.empty())
 			break;
 
-		if (sLine.front() == '#') {
+		if (sContent.front() == '#') {
 			if (isLoadingSprite) {
 				break;
 			}
@@ -637,52 +698,73 @@ bool cMapLoader::LoadMapLevel(const int& nMapLevel)
 		}
 
 		if (isLoadingSprite) {
-			LoadMapSprite(sLine);
+			LoadMapSprite(sLine, nLine);
 		}
 		else {
-			LoadMapLane(sLine);
+			LoadMapLane(sLine, nLine);
 		}
 	}
-	UpdatePattern();
+	return !HasMapError();
+}
+/// @brief Load map level, map sprite, and map name from file
+///	@param nMapLevel - Map level
+///	@return true if map level, map sprite, and map name were loaded successfully,
+bool cMapLoader::LoadMapLevel(const int& nMapLevel)
+{
+	TRACE_FUNCTION();
+	MapClear();
+	const std::string& sFileName = "data/maps/map" + std::to_string(nMapLevel) + ".txt";
+	std::ifstream ifs(sFileName, std::ios::binary | std::ios::ate);
+	if (!ifs.is_open()) {
+		Report(MapDiagnostic::MAP_ERROR, 0, 0, "failed to open file " + sFileName
+			+ " (working directory " + std::filesystem::current_path().string() + ")");
+		return false;
+	}
+
+	const std::streamoff nSize = ifs.tellg();
+	sFileBuffer.resize(nSize > 0 ? static_cast<size_t>(nSize) : 0);
+	ifs.seekg(0, std::ios::beg);
+	ifs.read(sFileBuffer.data(), static_cast<std::streamsize>(sFileBuffer.size()));
 	ifs.close();
-	return true;
+
+	const bool bSuccess = LoadMapBuffer(sFileBuffer);
+	return pRuntime->Compile(mapSprites, vecLanes, app_const::MAP_WIDTH_LIMIT) && bSuccess;
 }
-/// @brief Load map level by current map level
+/// @brief Load map level by current map level, using the prefetched level if available
 /// @return True if map level, map sprite, and map name were loaded successfully, false otherwise
 bool cMapLoader::LoadMapLevel()
 {
-	return LoadMapLevel(GetMapLevel());
+	TRACE_FUNCTION();
+	const bool bSuccess = SwapPrefetchedLevel(GetMapLevel()) || LoadMapLevel(GetMapLevel());
+	PrefetchNextLevel();
+	return bSuccess;
 }
 
-/// @brief 
-/// @param timeStr 
-/// @return 
-float cMapLoader::ExtractTime(const std::string& timeStr)
+/// @brief Convert a time string ("1.5s", "300ms", "20us", "10ns") to seconds
+/// @param sTime Time string
+/// @param nLine Line number in map file (for diagnostics)
+/// @param nColumn Column number in map file (for diagnostics)
+/// @return Time in seconds, 0 if the time string is invalid
+float cMapLoader::ExtractTime(const std::string_view sTime, const int nLine, const int nColumn)
 {
-	if (timeStr.empty()) {
-		std::cerr << "Invalid time string." << std::endl;
+	if (sTime.empty()) {
+		Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "invalid time string");
 		return 0.0;
 	}
 
-	float conversionFactor = 1.0;
-	std::string numericPart;
-	std::string timeType;
-
 	// Find the position of the first non-numeric character
 	size_t pos = 0;
-	while (pos < timeStr.size() && (std::isdigit(timeStr[pos]) || timeStr[pos] == '.')) {
-		numericPart += timeStr[pos];
+	while (pos < sTime.size() && (std::isdigit(static_cast<unsigned char>(sTime[pos])) || sTime[pos] == '.')) {
 		pos++;
 	}
-
-	if (pos < timeStr.size()) {
-		timeType = timeStr.substr(pos);
-	}
-	else {
-		std::cerr << "No time type specified in the time string." << std::endl;
+	const std::string_view numericPart = sTime.substr(0, pos);
+	const std::string_view timeType = sTime.substr(pos);
+	if (timeType.empty()) {
+		Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "no time type specified in the time string");
 		return 0.0;
 	}
 
+	float conversionFactor = 1.0;
 	if (timeType == "ms") {
 		conversionFactor = static_cast<float>(1.0e-3);
 	}
@@ -696,21 +778,89 @@ float cMapLoader::ExtractTime(const std::string& timeStr)
 		conversionFactor = static_cast <float>(1.0); // Seconds
 	}
 	else {
-		std::cerr << "Unrecognized time type: " << timeType << std::endl;
+		Report(MapDiagnostic::MAP_ERROR, nLine, nColumn + static_cast<int>(pos), "unrecognized time type \"" + std::string(timeType) + "\"");
 		return 0.0;
 	}
 
-	std::istringstream numericStream(numericPart);
-	float numericValue;
+	float numericValue = 0;
+	if (ParseNumber(numericPart, numericValue) != numericPart.data() + numericPart.size()) {
+		Report(MapDiagnostic::MAP_ERROR, nLine, nColumn, "invalid numeric part in the time string");
+		return 0.0;
+	}
+	return numericValue * conversionFactor;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// PREFETCHERS ///////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (numericStream >> numericValue) {
-		return numericValue * conversionFactor;
+/// @brief Start parsing a map level on a background thread, so that loading it later is a swap
+/// @param nLevel Map level to prefetch
+/// @return true if the level is being (or already) prefetched, false otherwise
+bool cMapLoader::PrefetchLevel(const int nLevel)
+{
+	if (nLevel < 0 || nLevel >= GetMapCount()) {
+		return false;
 	}
-	else {
-		std::cerr << "Invalid numeric part in the time string." << std::endl;
-		return 0.0;
+	if (nPrefetchLevel == nLevel && futurePrefetch.valid()) {
+		return true;
+	}
+	CancelPrefetch();
+	pPrefetchLoader = std::make_unique<cMapLoader>();
+	nPrefetchLevel = nLevel;
+	cMapLoader* pLoader = pPrefetchLoader.get();
+	futurePrefetch = std::async(std::launch::async, [pLoader, nLevel]() {
+		TRACE_THREAD("Prefetch");
+		return pLoader->LoadMapLevel(nLevel);
+		});
+	return true;
+}
+/// @brief Start prefetching the level following the current one (wraps around like NextLevel)
+/// @return true if the level is being prefetched, false otherwise
+bool cMapLoader::PrefetchNextLevel()
+{
+	const int nMapCount = GetMapCount();
+	if (nMapCount <= 0) {
+		return false;
 	}
+	return PrefetchLevel((GetMapLevel() + 1) % nMapCount);
 }
+/// @brief Check if the prefetched level has finished parsing
+bool cMapLoader::IsPrefetchReady() const
+{
+	return futurePrefetch.valid()
+		&& futurePrefetch.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+/// @brief Drop the prefetched level (waits for the background parsing to finish)
+void cMapLoader::CancelPrefetch()
+{
+	if (futurePrefetch.valid()) {
+		futurePrefetch.wait();
+		futurePrefetch = std::future<bool>();
+	}
+	pPrefetchLoader.reset();
+	nPrefetchLevel = -1;
+}
+/// @brief Replace current map data by the prefetched level (constant time swap of containers)
+/// @param nLevel Map level expected to be loaded
+/// @return true if the prefetched level was nLevel and loaded successfully, false otherwise
+bool cMapLoader::SwapPrefetchedLevel(const int nLevel)
+{
+	TRACE_FUNCTION();
+	if (nPrefetchLevel != nLevel || !futurePrefetch.valid()) {
+		return false;
+	}
+	const bool bSuccess = futurePrefetch.get();
+	if (bSuccess) {
+		mapSprites.swap(pPrefetchLoader->mapSprites);
+		vecLanes.swap(pPrefetchLoader->vecLanes);
+		pRuntime.swap(pPrefetchLoader->pRuntime);
+		vecDiagnostics.swap(pPrefetchLoader->vecDiagnostics);
+	}
+	CancelPrefetch();
+	return bSuccess;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////// END OF FILE /////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////
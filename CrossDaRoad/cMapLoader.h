@@ -3,13 +3,17 @@
 
 #include "uStringUtils.h"
 #include "uAppConst.h"
+#include "cMapRuntime.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cmath>
 #include <map>
+#include <memory>
+#include <future>
 
 /**
  * @file cMapLoader.h
@@ -44,7 +48,24 @@ struct SpriteData
 	SpriteData();						///< Constructor
 	~SpriteData();					 	///< Destructor
 	void debug(char end = '\n') const;  ///< Debug
-	bool SuccessSummon(int nCol, int nRow, float fCurrentTime, int fps) const;
+};
+
+/// @brief Diagnostic reported while parsing a map file
+struct MapDiagnostic
+{
+	/// @brief Severity of the diagnostic
+	enum Severity
+	{
+		MAP_WARNING, ///< The line was loaded, but part of it was ignored
+		MAP_ERROR,   ///< The line (or the file) could not be loaded
+	};
+
+	Severity eSeverity;   ///< Severity of the diagnostic
+	int nLine;            ///< Line number in map file (1-based, 0 if not related to a line)
+	int nColumn;          ///< Column number in map file (1-based)
+	std::string sMessage; ///< Description of the problem
+
+	std::string Show() const;
 };
 
 /// @brief Class for lane object in game
@@ -61,7 +82,7 @@ public: // Constructors & Destructor
 
 public: // Getters
 	float GetVelocity() const;
-	std::string GetLane() const;
+	const std::string& GetLane() const;
 
 public:	// Setters
 	void SetVelocity(float velocity);
@@ -75,12 +96,18 @@ private:
 	std::vector<cLane> vecLanes; ///< Vector of lanes in map
 	std::vector<std::string> vecMapNames; ///< Vector of map names
 	std::vector<std::string> vecMapDescriptions; ///< Vector of map descriptions
+	std::unique_ptr<cMapRuntime> pRuntime; ///< Compiled runtime form of the current map
+	std::vector<MapDiagnostic> vecDiagnostics; ///< Diagnostics reported while loading the current map
 
 private:
 	SpriteData currentSprite; ///< Current sprite data
-	std::string dangerPattern; ///< Danger pattern for map
-	std::string blockPattern; ///< Block pattern for map
 	int nMapLevel; ///< Current map level
+	std::string sFileBuffer; ///< Content of the map file being parsed (reused between loads)
+
+private: // Background prefetch
+	std::unique_ptr<cMapLoader> pPrefetchLoader; ///< Loader parsing the prefetched level in background
+	std::future<bool> futurePrefetch; ///< Result of the background parsing
+	int nPrefetchLevel; ///< Level being prefetched (-1 if none)
 
 public: // Constructors & Destructors
 	cMapLoader();
@@ -94,39 +121,52 @@ public: // Game Update
 	void MapClear();
 	void NextLevel();
 	void PrevLevel();
-	void UpdatePattern();
 
 public: // Getters
 	int GetMapLevel() const;
 	int GetMapCount() const;
-	SpriteData GetSpriteData(char graphic) const;
-	std::string GetDangerPattern();
-	std::string GetBlockPattern();
+	const SpriteData& GetSpriteData(char graphic) const;
+	const TileFlagTable& GetTileFlags() const;
 	std::string GetMapName(int nLevel) const;
 	std::string GetMapName() const;
 	std::string GetMapDescription(int nLevel) const;
 	std::string GetMapDescription() const;
-	std::vector<cLane> GetLanes() const;
-	cLane GetLane(int fPos) const;
-	cLane GetLaneFloor(float fPos) const;
-	cLane GetLaneRound(float fPos) const;
-	cLane GetLaneCeil(float fPos) const;
+	const std::vector<cLane>& GetLanes() const;
+	const cLane& GetLane(int fPos) const;
+	const cLane& GetLaneFloor(float fPos) const;
+	const cLane& GetLaneRound(float fPos) const;
+	const cLane& GetLaneCeil(float fPos) const;
+	const cMapRuntime& GetRuntime() const;
+	const std::vector<MapDiagnostic>& GetDiagnostics() const;
+	bool HasMapError() const;
 
 public: // Info getters
 	std::string ShowMapLevel() const;
 	std::string ShowMapInfo() const;
+	std::string ShowDiagnostics() const;
 
 public: // Setters
 	bool SetSpriteData(const SpriteData& data);
 	bool SetMapLevel(int MapLevel);
 
 public: // Loaders
-	bool LoadMapLane(const std::string& sLine, bool bDebug = false);
-	bool LoadMapSprite(const std::string& sLine, bool bDebug = false);
+	bool LoadMapLane(std::string_view sLine, int nLine = 0);
+	bool LoadMapSprite(std::string_view sLine, int nLine = 0);
 	bool LoadMapName(const std::string& sFileName);
+	bool LoadMapBuffer(std::string_view sBuffer);
 	bool LoadMapLevel(const int& nMapLevel);
 	bool LoadMapLevel();
-	float ExtractTime(const std::string& timeStr);
+	float ExtractTime(std::string_view sTime, int nLine = 0, int nColumn = 0);
+
+public: // Prefetchers
+	bool PrefetchLevel(int nLevel);
+	bool PrefetchNextLevel();
+	bool IsPrefetchReady() const;
+	void CancelPrefetch();
+
+private:
+	bool SwapPrefetchedLevel(int nLevel);
+	void Report(MapDiagnostic::Severity eSeverity, int nLine, int nColumn, std::string sMessage);
 };
 
 #endif // C_MAP_LOADER_H
@@ -0,0 +1,337 @@
+#include "cMapRuntime.h"
+#include "cMapLoader.h"
+#include "cAssetManager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+/**
+ * @file cMapRuntime.cpp
+ *
+ * @brief Contains MapTile struct and cMapRuntime class implementation
+ *
+ * This file implements MapTile struct and cMapRuntime class for the compiled runtime form of a map.
+**/
+
+// ==================================================================================================
+// ===================================== MapTile ====================================================
+// ==================================================================================================
+
+/// @brief Default constructor (empty tile, no property)
+MapTile::MapTile()
+{
+	uFlags = NONE;
+	uEncode = 0;
+	uSummon = 0;
+	uFrameCount = 0;
+	fPlatform = 0;
+	fDuration = 0;
+	fCooldown = 0;
+	fChance = 0;
+	nSpriteOriginX = 0;
+	nSpriteOriginY = 0;
+	nBackgroundOriginX = 0;
+	nBackgroundOriginY = 0;
+	pSprite = nullptr;
+	pBackground = nullptr;
+	uFrameOffset = 0;
+}
+
+/// @brief Check if the player can not move to this tile
+bool MapTile::IsBlocked() const
+{
+	return uFlags & BLOCKED;
+}
+/// @brief Check if the player is killed on this tile
+bool MapTile::IsDanger() const
+{
+	return uFlags & DANGER;
+}
+/// @brief Check if the player is carried by this tile
+bool MapTile::IsPlatform() const
+{
+	return uFlags & PLATFORM;
+}
+/// @brief Check if this tile can summon another tile
+bool MapTile::IsSummon() const
+{
+	return uFlags & SUMMON;
+}
+/// @brief Check if this tile has several sprite frames
+bool MapTile::IsAnimated() const
+{
+	return uFlags & ANIMATED;
+}
+
+// ==================================================================================================
+// ===================================== cMapRuntime ================================================
+// ==================================================================================================
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// CONSTRUCTORS & DESTRUCTOR ////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Default constructor
+cMapRuntime::cMapRuntime()
+{
+	nLaneWidth = app_const::MAP_WIDTH_LIMIT;
+	Clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// COMPILERS /////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Reset to an empty map, keeping allocated capacity for the next compilation
+void cMapRuntime::Clear()
+{
+	for (int nTile = 0; nTile < TILE_COUNT; nTile++) {
+		arrTiles[nTile] = MapTile();
+		arrTiles[nTile].uEncode = static_cast<uint8_t>(nTile);
+		arrTileInfos[nTile] = MapTileInfo();
+		arrTileInfos[nTile].encode = static_cast<char>(nTile);
+	}
+	arrFlags.fill(MapTile::NONE);
+	arrMasks.fill(app::SpriteMask());
+	vecFrames.clear();
+	vecFrameMasks.clear();
+	vecTiles.clear();
+	vecVelocities.clear();
+}
+
+/// @brief Compile parsed sprites and lanes into tile table and lane arrays
+/// @param mapSprites Parsed sprite data (key: encode)
+/// @param vecLanes Parsed lanes
+/// @param nWidth Number of tiles per lane (longer lanes are truncated, shorter lanes are padded with tile 0)
+/// @return true if compiled successfully, false otherwise
+bool cMapRuntime::Compile(const std::map<char, SpriteData>& mapSprites, const std::vector<cLane>& vecLanes, const int nWidth)
+{
+	Clear();
+	if (nWidth <= 0) {
+		std::cerr << "cMapRuntime::Compile(nWidth=" << nWidth << ") expected a positive lane width" << std::endl;
+		return false;
+	}
+	nLaneWidth = nWidth;
+
+	cAssetManager& assetManager = cAssetManager::GetInstance();
+	auto GetHandle = [&assetManager](const std::string& sName) -> const app::Sprite* {
+		return sName.empty() ? nullptr : assetManager.GetSprite(sName);
+		};
+	constexpr int32_t nSpriteWidth = app_const::SPRITE_WIDTH;
+	constexpr int32_t nSpriteHeight = app_const::SPRITE_HEIGHT;
+
+	for (const auto& [encode, sprite] : mapSprites) {
+		const auto uTile = static_cast<uint8_t>(encode);
+		MapTile& tile = arrTiles[uTile];
+		MapTileInfo& info = arrTileInfos[uTile];
+
+		info.encode = encode;
+		info.sSpriteName = sprite.sSpriteName;
+		info.sBackgroundName = sprite.sBackgroundName;
+		info.sCategory = sprite.sCategory;
+
+		tile.uEncode = uTile;
+		tile.fPlatform = sprite.fPlatform;
+		tile.fDuration = sprite.fDuration;
+		tile.fCooldown = sprite.fCooldown;
+		tile.fChance = sprite.fChance;
+		tile.nSpriteOriginX = sprite.nSpritePosX * app_const::SPRITE_WIDTH;
+		tile.nSpriteOriginY = sprite.nSpritePosY * app_const::SPRITE_HEIGHT;
+		tile.nBackgroundOriginX = sprite.nBackgroundPosX * app_const::SPRITE_WIDTH;
+		tile.nBackgroundOriginY = sprite.nBackgroundPosY * app_const::SPRITE_HEIGHT;
+		tile.pBackground = GetHandle(sprite.sBackgroundName);
+		auto GetMask = [&tile](const app::Sprite* pSprite) {
+			return app::SpriteMask::FromSprite(pSprite, tile.nSpriteOriginX, tile.nSpriteOriginY, nSpriteWidth, nSpriteHeight);
+			};
+
+		if (sprite.isBlocked) {
+			tile.uFlags |= MapTile::BLOCKED;
+		}
+		if (sprite.isDanger) {
+			tile.uFlags |= MapTile::DANGER;
+		}
+		if (!sprite.sSpriteName.empty() && std::fabs(sprite.fPlatform) > 0) {
+			tile.uFlags |= MapTile::PLATFORM;
+		}
+		if (sprite.summon != nullptr && sprite.fChance > 0) {
+			tile.uFlags |= MapTile::SUMMON;
+			tile.uSummon = static_cast<uint8_t>(sprite.summon->encode);
+		}
+
+		if (sprite.nID > 0 && !sprite.sSpriteName.empty()) {
+			// Frames are named "<sprite>1".."<sprite>N", slot 0 is kept empty so frame ID indexes directly
+			tile.uFlags |= MapTile::ANIMATED;
+			tile.uFrameCount = static_cast<uint8_t>(std::min(sprite.nID, 255));
+			tile.uFrameOffset = static_cast<uint32_t>(vecFrames.size());
+			vecFrames.push_back(nullptr);
+			vecFrameMasks.emplace_back();
+			for (int nFrame = 1; nFrame <= tile.uFrameCount; nFrame++) {
+				vecFrames.push_back(GetHandle(sprite.sSpriteName + std::to_string(nFrame)));
+				vecFrameMasks.push_back(tile.IsDanger() ? GetMask(vecFrames.back()) : app::SpriteMask());
+			}
+		}
+		else {
+			tile.pSprite = GetHandle(sprite.sSpriteName);
+			if (tile.IsDanger()) {
+				// A danger tile drawn without sprite (only background) is dangerous on its whole cell
+				arrMasks[uTile] = tile.pSprite ? GetMask(tile.pSprite) : app::SpriteMask::Full(nSpriteWidth, nSpriteHeight);
+			}
+		}
+		arrFlags[uTile] = tile.uFlags;
+	}
+
+	vecTiles.assign(vecLanes.size() * nLaneWidth, 0);
+	vecVelocities.resize(vecLanes.size());
+	for (size_t nRow = 0; nRow < vecLanes.size(); nRow++) {
+		const std::string& sLane = vecLanes[nRow].GetLane();
+		const size_t nCount = std::min(sLane.size(), static_cast<size_t>(nLaneWidth));
+		if (sLane.size() != static_cast<size_t>(nLaneWidth)) {
+			std::cerr << "Lane " << nRow << " has " << sLane.size() << " tiles, expected " << nLaneWidth << std::endl;
+		}
+		std::copy_n(sLane.begin(), nCount, vecTiles.begin() + nRow * nLaneWidth);
+		vecVelocities[nRow] = vecLanes[nRow].GetVelocity();
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// TILE GETTERS //////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Getter for hot tile properties
+/// @param uTile Tile ID (encode byte)
+const MapTile& cMapRuntime::GetTile(const uint8_t uTile) const
+{
+	return arrTiles[uTile];
+}
+/// @brief Getter for cold tile properties (names, category)
+/// @param uTile Tile ID (encode byte)
+const MapTileInfo& cMapRuntime::GetTileInfo(const uint8_t uTile) const
+{
+	return arrTileInfos[uTile];
+}
+/// @brief Getter for sprite handle of a tile at an animation frame
+/// @param tile Tile to draw
+/// @param nFrame Animation frame ID (1..uFrameCount), ignored if the tile is not animated
+/// @return Sprite handle, nullptr if nothing to draw
+const app::Sprite* cMapRuntime::GetTileSprite(const MapTile& tile, const int nFrame) const
+{
+	if (!tile.IsAnimated()) {
+		return tile.pSprite;
+	}
+	if (nFrame <= 0 || nFrame > tile.uFrameCount) {
+		return nullptr;
+	}
+	return vecFrames[tile.uFrameOffset + nFrame];
+}
+
+/// @brief Getter for opacity mask of a danger tile at an animation frame
+/// @param tile Tile to test
+/// @param nFrame Animation frame ID (1..uFrameCount), ignored if the tile is not animated
+/// @return Opacity mask of what is drawn for the tile, empty if nothing is drawn or the tile is not danger
+const app::SpriteMask& cMapRuntime::GetTileMask(const MapTile& tile, const int nFrame) const
+{
+	static const app::SpriteMask emptyMask;
+	if (!tile.IsAnimated()) {
+		return arrMasks[tile.uEncode];
+	}
+	if (nFrame <= 0 || nFrame > tile.uFrameCount) {
+		return emptyMask;
+	}
+	return vecFrameMasks[tile.uFrameOffset + nFrame];
+}
+/// @brief Getter for flags of all tiles (key: encode byte)
+const TileFlagTable& cMapRuntime::GetTileFlags() const
+{
+	return arrFlags;
+}
+/// @brief Check if a tile has a property
+/// @param uTile Tile ID (encode byte)
+/// @param eFlag Property to check
+bool cMapRuntime::HasTileFlag(const uint8_t uTile, const MapTile::Flag eFlag) const
+{
+	return arrFlags[uTile] & eFlag;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// LANE GETTERS //////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Getter for number of lanes
+int cMapRuntime::GetLaneCount() const
+{
+	return static_cast<int>(vecVelocities.size());
+}
+/// @brief Getter for number of tiles per lane
+int cMapRuntime::GetLaneWidth() const
+{
+	return nLaneWidth;
+}
+/// @brief Check if a lane exists
+/// @param nRow Index of the lane
+bool cMapRuntime::IsLaneInside(const int nRow) const
+{
+	return 0 <= nRow && nRow < GetLaneCount();
+}
+/// @brief Getter for velocity of a lane
+/// @param nRow Index of the lane
+/// @return Velocity of the lane, 0 if the lane does not exist
+float cMapRuntime::GetLaneVelocity(const int nRow) const
+{
+	return IsLaneInside(nRow) ? vecVelocities[nRow] : 0.0f;
+}
+/// @brief Getter for contiguous tile IDs of a lane
+/// @param nRow Index of the lane
+/// @return Pointer to nLaneWidth tile IDs, nullptr if the lane does not exist
+const uint8_t* cMapRuntime::GetLaneTiles(const int nRow) const
+{
+	return IsLaneInside(nRow) ? vecTiles.data() + static_cast<size_t>(nRow) * nLaneWidth : nullptr;
+}
+/// @brief Getter for tile ID at (row, column)
+/// @param nRow Index of the lane
+/// @param nCol Index of the tile in lane (wrapped around lane width)
+/// @return Tile ID, 0 if the lane does not exist
+uint8_t cMapRuntime::GetLaneTile(const int nRow, const int nCol) const
+{
+	if (!IsLaneInside(nRow)) {
+		return 0;
+	}
+	int nWrapped = nCol % nLaneWidth;
+	if (nWrapped < 0) {
+		nWrapped += nLaneWidth;
+	}
+	return vecTiles[static_cast<size_t>(nRow) * nLaneWidth + nWrapped];
+}
+/// @brief Getter for the lane column drawn first (leftmost) at a time
+/// @param nRow Index of the lane
+/// @param fTime Time since the lanes started moving (in seconds)
+/// @return Column in [0, lane width]
+int cMapRuntime::GetLaneScrollTile(const int nRow, const float fTime) const
+{
+	int nStartPos = static_cast<int>(fTime * GetLaneVelocity(nRow)) % nLaneWidth;
+	if (nStartPos < 0)
+		nStartPos = nLaneWidth - (std::abs(nStartPos) % nLaneWidth);
+	return nStartPos;
+}
+/// @brief Getter for the sub-cell pixel offset of a lane at a time
+/// @param nRow Index of the lane
+/// @param fTime Time since the lanes started moving (in seconds)
+/// @param nCellSize Size of a cell (in pixels)
+/// @return Offset in (-nCellSize, nCellSize), cells are drawn shifted left by this offset
+int cMapRuntime::GetLaneScrollOffset(const int nRow, const float fTime, const int nCellSize) const
+{
+	return static_cast<int>(static_cast<float>(nCellSize) * fTime * GetLaneVelocity(nRow)) % nCellSize;
+}
+/// @brief Getter for the total pixel distance a lane has scrolled at a time
+/// @param nRow Index of the lane
+/// @param fTime Time since the lanes started moving (in seconds)
+/// @param nCellSize Size of a cell (in pixels)
+/// @return Distance (in pixels, negative if moving left), tile j is drawn at x = j * nCellSize - distance (mod lane length)
+int cMapRuntime::GetLaneScroll(const int nRow, const float fTime, const int nCellSize) const
+{
+	return static_cast<int>(static_cast<float>(nCellSize) * fTime * GetLaneVelocity(nRow));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// END OF FILE /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
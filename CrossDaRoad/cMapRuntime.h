@@ -0,0 +1,121 @@
+#ifndef C_MAP_RUNTIME_H
+#define C_MAP_RUNTIME_H
+
+#include "gSprite.h"
+#include "gSpriteMask.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @file cMapRuntime.h
+ *
+ * @brief Contains MapTile struct, MapTileInfo struct, and cMapRuntime class
+ *
+ * This file contains the compiled, immutable runtime form of a map. The map loader parses a map file
+ * into SpriteData and cLane, then compiles them into a 256-entry tile table (indexed by encode byte)
+ * and contiguous lane tile arrays, so that per-frame map access never allocates.
+**/
+
+struct SpriteData;
+class cLane;
+
+/// @brief Hot tile properties, read every frame by rendering and collision detection
+struct MapTile
+{
+	/// @brief Bit flags of tile properties
+	enum Flag : uint8_t
+	{
+		NONE = 0,          ///< No property
+		BLOCKED = 1 << 0,  ///< The player can not move here
+		DANGER = 1 << 1,   ///< The player is killed here
+		PLATFORM = 1 << 2, ///< The player is carried by this tile
+		SUMMON = 1 << 3,   ///< This tile can summon another tile
+		ANIMATED = 1 << 4, ///< This tile has several sprite frames
+		// Bits 5..7 are free for new properties, set them in cMapRuntime::Compile
+	};
+
+	uint8_t uFlags;           ///< Combination of Flag values
+	uint8_t uEncode;          ///< Encode byte of this tile (index in tile table)
+	uint8_t uSummon;          ///< Encode byte of the summoned tile (0 if none)
+	uint8_t uFrameCount;      ///< Number of sprite frames (0 if not animated)
+	float fPlatform;          ///< Platform dragging speed if the player land on them
+	float fDuration;          ///< The duration (in seconds) of the summoned tile
+	float fCooldown;          ///< The cooldown durations for the two consecutive summoning
+	float fChance;            ///< The probability of summoning in each second
+	int32_t nSpriteOriginX;   ///< X origin (in pixels) of the sprite part being drawn
+	int32_t nSpriteOriginY;   ///< Y origin (in pixels) of the sprite part being drawn
+	int32_t nBackgroundOriginX; ///< X origin (in pixels) of the background part being drawn
+	int32_t nBackgroundOriginY; ///< Y origin (in pixels) of the background part being drawn
+	const app::Sprite* pSprite;     ///< Sprite handle (nullptr if none or animated)
+	const app::Sprite* pBackground; ///< Background handle (nullptr if none)
+	uint32_t uFrameOffset;    ///< Offset of the first animation frame in the frame pool
+
+	MapTile();
+	bool IsBlocked() const;
+	bool IsDanger() const;
+	bool IsPlatform() const;
+	bool IsSummon() const;
+	bool IsAnimated() const;
+};
+
+/// @brief Flags (MapTile::Flag) of all tiles indexed by encode byte, a property check is one load
+using TileFlagTable = std::array<uint8_t, 256>;
+
+/// @brief Cold tile properties, only used for debugging and messages
+struct MapTileInfo
+{
+	char encode;                 ///< Sprite encode chacters for map editor
+	std::string sSpriteName;     ///< Sprite name (*.png)
+	std::string sBackgroundName; ///< Background name (*.png)
+	std::string sCategory;       ///< Category, allow categorize configuration if needed
+};
+
+/// @brief Immutable runtime form of a map, compiled from parsed sprites and lanes
+class cMapRuntime
+{
+public:
+	static constexpr int TILE_COUNT = 256; ///< Number of entries in the tile table
+
+private:
+	std::array<MapTile, TILE_COUNT> arrTiles;         ///< Hot tile table (key: encode byte)
+	std::array<MapTileInfo, TILE_COUNT> arrTileInfos; ///< Cold tile table (key: encode byte)
+	TileFlagTable arrFlags;                           ///< Flags of the hot tile table, packed in 256 bytes
+	std::vector<const app::Sprite*> vecFrames;        ///< Animation frame handles of all animated tiles
+	std::array<app::SpriteMask, TILE_COUNT> arrMasks; ///< Opacity masks of danger tiles (key: encode byte)
+	std::vector<app::SpriteMask> vecFrameMasks;       ///< Opacity masks of animation frames (parallel to vecFrames)
+	std::vector<uint8_t> vecTiles;                    ///< Tile IDs of all lanes, one row of nLaneWidth per lane
+	std::vector<float> vecVelocities;                 ///< Velocity of each lane
+	int nLaneWidth;                                   ///< Number of tiles per lane
+
+public: // Constructors & Destructor
+	cMapRuntime();
+	~cMapRuntime() = default;
+
+public: // Compilers
+	void Clear();
+	bool Compile(const std::map<char, SpriteData>& mapSprites, const std::vector<cLane>& vecLanes, int nWidth);
+
+public: // Tile getters
+	const MapTile& GetTile(uint8_t uTile) const;
+	const MapTileInfo& GetTileInfo(uint8_t uTile) const;
+	const app::Sprite* GetTileSprite(const MapTile& tile, int nFrame) const;
+	const app::SpriteMask& GetTileMask(const MapTile& tile, int nFrame) const;
+	const TileFlagTable& GetTileFlags() const;
+	bool HasTileFlag(uint8_t uTile, MapTile::Flag eFlag) const;
+
+public: // Lane getters
+	int GetLaneCount() const;
+	int GetLaneWidth() const;
+	bool IsLaneInside(int nRow) const;
+	float GetLaneVelocity(int nRow) const;
+	const uint8_t* GetLaneTiles(int nRow) const;
+	uint8_t GetLaneTile(int nRow, int nCol) const;
+	int GetLaneScrollTile(int nRow, float fTime) const;
+	int GetLaneScrollOffset(int nRow, float fTime, int nCellSize) const;
+	int GetLaneScroll(int nRow, float fTime, int nCellSize) const;
+};
+
+#endif // C_MAP_RUNTIME_H
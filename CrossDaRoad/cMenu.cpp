@@ -63,8 +63,9 @@ bool cMenu::LoadOption(cApp* App)
 			break;
 		case 1:
 			eAppOption = cMenu::Option::CONTINUE;
-			App->GameReset();
-			App->OnGameLoad();
+			if (!App->OnGameLoad()) { // No save loaded: continue on a fresh game
+				App->GameReset();
+			}
 			break;
 		case 2:
 			eAppOption = cMenu::Option::SETTINGS;
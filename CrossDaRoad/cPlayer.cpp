@@ -1,7 +1,10 @@
 #include "cPlayer.h"
-#include "cZone.h"
+#include "cCollisionQuery.h"
 #include "cApp.h"
+#include "gTrace.h"
 #include "uAppConst.h"
+#include <algorithm>
+#include <cmath>
 
 /**
  * @file cPlayer.cpp
@@ -48,17 +51,10 @@ void cPlayer::ResetDirection()
 /// @brief Reset player animation
 void cPlayer::ResetAnimation()
 {
-	frame4_id = 0;
-	frame4_id_limit = 4;
-
-	frame6_id = 0;
-	frame6_id_limit = 6;
-	frame6_id_safe = 6;
-	/// todo: id_safe for background detection is high (6)
+	nJumpFrame = 0;
+	nJumpTick = 0;
+	/// todo: JUMP_SAFE_FRAME for background detection is high (6)
 	   ///           but for deadly objects is smaller for friendly jump
-	frame6_val = 0;
-	frame6_val_cur = 0;
-	frame6_val_last = 0;
 }
 /// @brief Reset player position
 void cPlayer::ResetPosition()
@@ -67,6 +63,8 @@ void cPlayer::ResetPosition()
 	fFrogAnimPosY = app_const::FROG_Y_RESET;
 	fFrogLogicPosX = app_const::FROG_X_RESET;
 	fFrogLogicPosY = app_const::FROG_Y_RESET;
+	fFrogPrevAnimPosX = fFrogAnimPosX;
+	fFrogPrevAnimPosY = fFrogAnimPosY;
 }
 /// @brief Reset player velocity
 void cPlayer::ResetVelocity()
@@ -88,6 +86,18 @@ void cPlayer::SetupTarget(cApp* app)
 {
 	this->app = app;
 }
+/// @brief Look up handles and build opacity masks of all player sprites, register player animations
+/// (after sprites are loaded and app is set up)
+void cPlayer::LoadSprites()
+{
+	for (int nSpriteIndex = 0; nSpriteIndex < static_cast<int>(arrSprites.size()); nSpriteIndex++) {
+		arrSprites[nSpriteIndex] = cAssetManager::GetInstance().GetSprite(GetSpriteName(nSpriteIndex));
+		arrMasks[nSpriteIndex] = app::SpriteMask::FromSprite(arrSprites[nSpriteIndex]);
+	}
+	// Jump sprites depend on the direction, so the jump animation only times the frames
+	nJumpAnimation = app->Animation.Register("", app_const::JUMP_FRAMES, app_const::JUMP_FRAME_TIME, cAnimationClock::ONCE);
+	nDeathAnimation = app->Animation.Register("froggy_death", app_const::DEATH_FRAMES, app_const::DEATH_FRAME_TIME, cAnimationClock::ONCE);
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////// CHECKERS /////////////////////////////////////////////////////////////
@@ -132,12 +142,12 @@ bool cPlayer::IsPlayerIdling() const
 
 bool cPlayer::IsPlayerLanding() const
 {
-	return frame6_id > frame6_id_limit;
+	return nJumpFrame > app_const::JUMP_FRAMES;
 }
 
 bool cPlayer::IsPlayerCollisionSafe() const
 {
-	return frame6_id <= frame6_id_safe;
+	return nJumpFrame <= app_const::JUMP_SAFE_FRAME;
 }
 /// @brief Check if player is out of bounds of map border
 bool cPlayer::IsPlayerOutOfBounds() const
@@ -166,7 +176,7 @@ bool cPlayer::IsHitTopLeft() const
 {
 	const float fPosX = GetPlayerLogicPositionX();
 	const float fPosY = GetPlayerLogicPositionY();
-	const bool isHitTopLeft = app->Zone.IsDangerTopLeft(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isHitTopLeft = app->Collision.IsDangerTopLeft(fPosX, fPosY, app_const::CELL_SIZE);
 	return isHitTopLeft;
 }
 /// @brief Check if player is hit by danger zone at top right corner
@@ -174,7 +184,7 @@ bool cPlayer::IsHitTopRight() const
 {
 	const float fPosX = GetPlayerLogicPositionX();
 	const float fPosY = GetPlayerLogicPositionY();
-	const bool isHitTopRight = app->Zone.IsDangerTopRight(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isHitTopRight = app->Collision.IsDangerTopRight(fPosX, fPosY, app_const::CELL_SIZE);
 	return isHitTopRight;
 }
 /// @brief Check if player is hit by danger zone at bottom left corner
@@ -182,7 +192,7 @@ bool cPlayer::IsHitBottomLeft() const
 {
 	const float fPosX = GetPlayerLogicPositionX();
 	const float fPosY = GetPlayerLogicPositionY();
-	const bool isHitBottomLeft = app->Zone.IsDangerBottomLeft(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isHitBottomLeft = app->Collision.IsDangerBottomLeft(fPosX, fPosY, app_const::CELL_SIZE);
 	return isHitBottomLeft;
 }
 /// @brief Check if player is hit by danger zone at bottom right corner
@@ -190,12 +200,22 @@ bool cPlayer::IsHitBottomRight() const
 {
 	const float fPosX = GetPlayerLogicPositionX();
 	const float fPosY = GetPlayerLogicPositionY();
-	const bool isHitBottomRight = app->Zone.IsDangerBottomRight(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isHitBottomRight = app->Collision.IsDangerBottomRight(fPosX, fPosY, app_const::CELL_SIZE);
 	return isHitBottomRight;
 }
-/// @brief Check if player is hit by danger zone
+/// @brief Check if opaque pixels of the current player sprite touch opaque pixels of a danger tile
+bool cPlayer::IsHitPixel() const
+{
+	const int nPosX = static_cast<int>(GetPlayerLogicPositionX() * app_const::CELL_SIZE);
+	const int nPosY = static_cast<int>(GetPlayerLogicPositionY() * app_const::CELL_SIZE);
+	return app->Collision.IsDangerMask(GetPlayerMask(), nPosX, nPosY);
+}
+/// @brief Check if player is hit by danger zone (pixel-perfect if enabled for the map)
 bool cPlayer::IsHit() const
 {
+	if (app->bPixelCollision) {
+		return IsHitPixel();
+	}
 	return IsHitTopLeft()
 		|| IsHitTopRight()
 		|| IsHitBottomLeft()
@@ -206,7 +226,7 @@ bool cPlayer::IsBlockedTopLeft() const
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	const bool isBlockedTopLeft = app->Zone.IsBlockedTopLeft(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isBlockedTopLeft = app->Collision.IsBlockedTopLeft(fPosX, fPosY, app_const::CELL_SIZE);
 	return isBlockedTopLeft;
 }
 /// @brief Check if player is blocked by block zone at top right corner
@@ -214,7 +234,7 @@ bool cPlayer::IsBlockedTopRight() const
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	const bool isBlockedTopRight = app->Zone.IsBlockedTopRight(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isBlockedTopRight = app->Collision.IsBlockedTopRight(fPosX, fPosY, app_const::CELL_SIZE);
 	return isBlockedTopRight;
 }
 /// @brief Check if player is blocked by block zone at bottom left corner
@@ -222,7 +242,7 @@ bool cPlayer::IsBlockedBottomLeft() const
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	const bool isBlockedBottomLeft = app->Zone.IsBlockedBottomLeft(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isBlockedBottomLeft = app->Collision.IsBlockedBottomLeft(fPosX, fPosY, app_const::CELL_SIZE);
 	return isBlockedBottomLeft;
 }
 /// @brief Check if player is blocked by block zone at bottom right corner
@@ -230,7 +250,7 @@ bool cPlayer::IsBlockedBottomRight() const
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	const bool isBlockedBottomRight = app->Zone.IsBlockedBottomRight(fPosX, fPosY, app_const::CELL_SIZE);
+	const bool isBlockedBottomRight = app->Collision.IsBlockedBottomRight(fPosX, fPosY, app_const::CELL_SIZE);
 	return isBlockedBottomRight;
 }
 /// @brief Check if player is blocked by block zone
@@ -290,20 +310,32 @@ cPlayer::Animation cPlayer::GetAnimation() const
 	return eAnimation;
 }
 
-int cPlayer::GetFrameID(const frame_t frame) const
+/// @brief Getter for index of the sprite drawn for the player
+/// @return 0 if idle, jump frame ID (1..JUMP_FRAMES) if jumping, plus SPRITE_VARIANTS if facing left
+int cPlayer::GetSpriteIndex() const
 {
-	if (frame == frame4_id_limit) {
-		return frame4_id;
-	}
-	else if (frame == frame6_id_limit) {
-		return frame6_id;
-	}
-	return 0;
+	const bool isValidID = (1 <= nJumpFrame && nJumpFrame <= app_const::JUMP_FRAMES);
+	const bool isJump = (IsPlayerJumping()) && (isValidID);
+	return (IsLeftDirection() ? SPRITE_VARIANTS : 0) + (isJump ? nJumpFrame : 0);
 }
 
-std::string cPlayer::ShowFrameID(const frame_t frame) const
+/// @brief Getter for name of a player sprite
+/// @param nSpriteIndex index of the sprite (see GetSpriteIndex)
+std::string cPlayer::GetSpriteName(const int nSpriteIndex)
 {
-	return std::to_string(GetFrameID(frame));
+	const int nFrameID = nSpriteIndex % SPRITE_VARIANTS;
+	const bool isLeft = nSpriteIndex >= SPRITE_VARIANTS;
+	const bool isJump = nFrameID > 0;
+	const std::string froggy_state = std::string(isJump ? "_jump" : "");
+	const std::string froggy_direction = std::string(isLeft ? "_left" : "");
+	const std::string froggy_id = (isJump ? std::to_string(nFrameID) : "");
+	return "froggy" + froggy_state + froggy_direction + froggy_id;
+}
+
+/// @brief Getter for opacity mask of the sprite drawn for the player
+const app::SpriteMask& cPlayer::GetPlayerMask() const
+{
+	return arrMasks[GetSpriteIndex()];
 }
 
 float cPlayer::GetPlayerAnimationPositionX() const
@@ -402,29 +434,33 @@ void cPlayer::SetPlayerLogicPosition(float fPositionX, float fPositionY)
 ////////////////////////////////////////// MOVEMENTS ///////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief Move the animation position along x, by the largest of nStep + 1 evenly spaced candidate offsets
+/// that is not blocked (no move if the Player is out of bounds)
 bool cPlayer::PlayerMoveX(float fFactorX, int nStep)
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	for (int nPos = nStep; nPos >= 0; --nPos) {
-		const float fOffsetPartialX = app_const::FROG_X_VELOCITY * fFactorX * nPos / nStep;
-		SetPlayerAnimationPosition(fPosX + fOffsetPartialX, fPosY);
-		if (!IsBlocked() && !IsPlayerOutOfBounds()) {
-			break;
-		}
+	const float fOffsetX = app_const::FROG_X_VELOCITY * fFactorX;
+	int nPos = IsPlayerOutOfBounds() ? 0 : GetFreeSteps(fOffsetX, 0, nStep);
+	SetPlayerAnimationPosition(fPosX + fOffsetX * nPos / nStep, fPosY);
+	while (nPos > 0 && IsBlocked()) { // Already overlapping a blocked tile, or rounded onto its edge
+		--nPos;
+		SetPlayerAnimationPosition(fPosX + fOffsetX * nPos / nStep, fPosY);
 	}
 	return true;
 }
+/// @brief Move the animation position along y, by the largest of nStep + 1 evenly spaced candidate offsets
+/// that is not blocked (no move if the Player is out of bounds)
 bool cPlayer::PlayerMoveY(float fFactorY, int nStep)
 {
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
-	for (int nPos = nStep; nPos >= 0; --nPos) {
-		const float fOffsetPartialY = app_const::FROG_Y_VELOCITY * fFactorY * nPos / nStep;
-		SetPlayerAnimationPosition(fPosX, fPosY + fOffsetPartialY);
-		if (!IsBlocked() && !IsPlayerOutOfBounds()) {
-			break;
-		}
+	const float fOffsetY = app_const::FROG_Y_VELOCITY * fFactorY;
+	int nPos = IsPlayerOutOfBounds() ? 0 : GetFreeSteps(0, fOffsetY, nStep);
+	SetPlayerAnimationPosition(fPosX, fPosY + fOffsetY * nPos / nStep);
+	while (nPos > 0 && IsBlocked()) { // Already overlapping a blocked tile, or rounded onto its edge
+		--nPos;
+		SetPlayerAnimationPosition(fPosX, fPosY + fOffsetY * nPos / nStep);
 	}
 	return true;
 }
@@ -475,38 +511,24 @@ bool cPlayer::PlayerMoveTryAll(float factor, bool forced)
 	ok &= PlayerMoveDown(factor, forced);
 	return ok;
 }
+/// @brief Move Player to the nearest safe offset, within nStep steps of fFactor cells, when it stands in danger
+/// @return false if Player was moved out of danger, true otherwise
 bool cPlayer::PlayerPlatformDetector(int nStep, float fFactor)
 {
-	if (app->IsMoveRight() && app->IsKilled()) {
-		for (int step = 1; step <= nStep; ++step) {
-			PlayerMoveRight(fFactor, true);
-			if (!app->IsKilled()) {
-				return false;
-			}
-		}
-		for (int step = 1; step <= nStep; ++step) {
-			PlayerMoveLeft(fFactor, true);
-			if (!app->IsKilled()) {
-				return false;
-			}
-		}
+	const bool bRightFirst = app->IsMoveRight();
+	if ((!bRightFirst && app->IsMoveLeft()) || !app->IsKilled()) {
+		return true;
 	}
-	if (!app->IsMoveLeft() && app->IsKilled()) {
-		for (int step = 1; step <= nStep; ++step) {
-			PlayerMoveLeft(fFactor, true);
-			if (!app->IsKilled()) {
-				return false;
-			}
-		}
-		for (int step = 1; step <= nStep; ++step) {
-			PlayerMoveRight(fFactor, true);
-			if (!app->IsKilled()) {
-				return false;
-			}
-		}
+	const int nMaxOffset = static_cast<int>(std::round(nStep * fFactor * app_const::CELL_SIZE));
+	if (PlayerMoveToSafeOffset(bRightFirst ? +1 : -1, nMaxOffset)) {
+		return false;
+	}
+	if (PlayerMoveToSafeOffset(bRightFirst ? -1 : +1, nMaxOffset)) {
+		return false;
 	}
 	return true;
 }
+/// @brief Move both positions along x, by the largest of nStep + 1 evenly spaced candidate offsets that is not blocked
 bool cPlayer::PlayerPlatformMoveX(float fFactorX, int nStep)
 {
 	const float fRealPosX = GetPlayerLogicPositionX();
@@ -514,16 +536,19 @@ bool cPlayer::PlayerPlatformMoveX(float fFactorX, int nStep)
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
 	const float fOffsetX = app_const::FROG_X_VELOCITY * fFactorX;
-	for (int nPos = nStep; nPos >= 0; --nPos) {
-		const float fOffsetPartialX = app_const::FROG_X_VELOCITY * fFactorX * nPos / nStep;
+	int nPos = GetFreeSteps(fOffsetX, 0, nStep);
+	while (true) {
+		const float fOffsetPartialX = fOffsetX * nPos / nStep;
 		SetPlayerAnimationPosition(fPosX + fOffsetPartialX, fPosY);
 		SetPlayerLogicPosition(fRealPosX + fOffsetPartialX, fRealPosY);
-		if (!IsBlocked()) {
+		if (nPos == 0 || !IsBlocked()) { // Already overlapping a blocked tile, or rounded onto its edge
 			break;
 		}
+		--nPos;
 	}
 	return true;
 }
+/// @brief Move both positions along y, by the largest of nStep + 1 evenly spaced candidate offsets that is not blocked
 bool cPlayer::PlayerPlatformMoveY(float fFactorY, int nStep)
 {
 	const float fRealPosX = GetPlayerLogicPositionX();
@@ -531,13 +556,15 @@ bool cPlayer::PlayerPlatformMoveY(float fFactorY, int nStep)
 	const float fPosX = GetPlayerAnimationPositionX();
 	const float fPosY = GetPlayerAnimationPositionY();
 	const float fOffsetY = app_const::FROG_Y_VELOCITY * fFactorY;
-	for (int nPos = nStep; nPos >= 0; --nPos) {
-		const float fOffsetPartialY = app_const::FROG_Y_VELOCITY * fFactorY * nPos / nStep;
+	int nPos = GetFreeSteps(0, fOffsetY, nStep);
+	while (true) {
+		const float fOffsetPartialY = fOffsetY * nPos / nStep;
 		SetPlayerAnimationPosition(fPosX, fPosY + fOffsetPartialY);
 		SetPlayerLogicPosition(fRealPosX, fRealPosY + fOffsetPartialY);
-		if (!IsBlocked()) {
+		if (nPos == 0 || !IsBlocked()) { // Already overlapping a blocked tile, or rounded onto its edge
 			break;
 		}
+		--nPos;
 	}
 	return true;
 }
@@ -545,6 +572,57 @@ bool cPlayer::PlayerPlatformMove(float fFactorX, float fFactorY, float fFactorSc
 {
 	return PlayerPlatformMoveX(fFactorX * fFactorScale) && PlayerPlatformMoveY(fFactorY * fFactorScale);
 }
+/// @brief Move both positions to the nearest offset along x where the lane tiles do not kill Player
+/// @param nDirection +1 to search right, -1 to search left
+/// @param nMaxOffset Largest offset to search (in pixels), Player stays inside the borders
+/// @return true if Player was moved out of danger, false otherwise (Player is not moved)
+bool cPlayer::PlayerMoveToSafeOffset(int nDirection, int nMaxOffset)
+{
+	const float fRealPosX = GetPlayerLogicPositionX();
+	const float fRealPosY = GetPlayerLogicPositionY();
+	const float fPosX = GetPlayerAnimationPositionX();
+	const float fPosY = GetPlayerAnimationPositionY();
+	const float fRoom = nDirection > 0 ? app_const::RIGHT_BORDER - fRealPosX : fRealPosX - app_const::LEFT_BORDER;
+	const int nLimit = std::min(nMaxOffset, static_cast<int>(std::floor(fRoom * app_const::CELL_SIZE)));
+	int nOffset = 0;
+	if (nLimit <= 0 || !app->Collision.FindSafeOffsetX(fRealPosX, fRealPosY, app_const::CELL_SIZE, nDirection, nLimit, nOffset)) {
+		return false;
+	}
+	const float fOffsetX = static_cast<float>(nDirection * nOffset) / app_const::CELL_SIZE;
+	SetPlayerAnimationPosition(fPosX + fOffsetX, fPosY);
+	SetPlayerLogicPosition(fRealPosX + fOffsetX, fRealPosY);
+	if (IsBlocked() || app->IsKilled()) { // Blocked there, or still touching with pixel-perfect collision
+		SetPlayerAnimationPosition(fPosX, fPosY);
+		SetPlayerLogicPosition(fRealPosX, fRealPosY);
+		return false;
+	}
+	return true;
+}
+/// @brief Number of candidate steps of a move (out of nStep, from the largest) that fit before the blocked tile ahead
+/// @param fOffsetX Offset of the whole move along x (in cells, 0 for a move along y)
+/// @param fOffsetY Offset of the whole move along y (in cells)
+/// @param nStep Number of candidate steps of the move
+/// @return The largest candidate step whose leading corners do not reach the blocked tile ahead
+int cPlayer::GetFreeSteps(float fOffsetX, float fOffsetY, int nStep) const
+{
+	const float fOffset = fOffsetX != 0 ? fOffsetX : fOffsetY;
+	if (fOffset == 0 || nStep <= 0) {
+		return std::max(nStep, 0);
+	}
+	const float fPosX = GetPlayerAnimationPositionX();
+	const float fPosY = GetPlayerAnimationPositionY();
+	const int nDirection = fOffset > 0 ? +1 : -1;
+	const float fDistance = fOffsetX != 0
+		? app->Collision.GetBlockDistanceX(fPosX, fPosY, app_const::CELL_SIZE, nDirection)
+		: app->Collision.GetBlockDistanceY(fPosX, fPosY, app_const::CELL_SIZE, nDirection);
+	if (fDistance < 0) {
+		return nStep;
+	}
+	// Candidate step n moves the leading corners by n steps of fStepPixels, blocked once they cover fDistance
+	const float fStepPixels = std::fabs(fOffset) * app_const::CELL_SIZE / static_cast<float>(nStep);
+	const int nFree = static_cast<int>(std::ceil(fDistance / fStepPixels)) - 1;
+	return std::clamp(nFree, 0, nStep);
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////// LOGIC UPDATES ////////////////////////////////////////////////////////////
@@ -563,25 +641,26 @@ bool cPlayer::OnUpdatePlayerJumpContinue()
 	if (GetAnimation() == IDLE) {
 		return false;
 	}
-	if (frame6_val_cur < frame6_val) {
-		frame6_val_cur = frame6_val;
+	const int nTick = app->Animation.GetTick(nJumpAnimation);
+	if (nJumpTick < nTick) {
+		nJumpTick = nTick;
 		if (GetDirection() == LEFT) {
-			if (!PlayerMoveLeft(fFrogVelocityX / frame6_id_limit, true)) {
+			if (!PlayerMoveLeft(fFrogVelocityX / app_const::JUMP_FRAMES, true)) {
 				return false;
 			}
 		}
 		else if (GetDirection() == RIGHT) {
-			if (!PlayerMoveRight(fFrogVelocityX / frame6_id_limit, true)) {
+			if (!PlayerMoveRight(fFrogVelocityX / app_const::JUMP_FRAMES, true)) {
 				return false;
 			}
 		}
 		else if (GetDirection() == LEFT_UP || GetDirection() == RIGHT_UP) {
-			if (!PlayerMoveUp(fFrogVelocityY / frame6_id_limit, true)) {
+			if (!PlayerMoveUp(fFrogVelocityY / app_const::JUMP_FRAMES, true)) {
 				return false;
 			}
 		}
 		else if (GetDirection() == LEFT_DOWN || GetDirection() == RIGHT_DOWN) {
-			if (!PlayerMoveDown(fFrogVelocityY / frame6_id_limit, true)) {
+			if (!PlayerMoveDown(fFrogVelocityY / app_const::JUMP_FRAMES, true)) {
 				return false;
 			}
 		}
@@ -613,8 +692,8 @@ bool cPlayer::OnRenderPlayerIdle()
 
 bool cPlayer::OnRenderPlayerJumpStart()
 {
-	frame6_val_last = frame6_val;
-	frame6_id = (frame6_val - frame6_val_last + 1);
+	app->Animation.Restart(nJumpAnimation);
+	nJumpFrame = app->Animation.GetFrame(nJumpAnimation);
 	SetPlayerLogicPosition(fFrogAnimPosX, fFrogAnimPosY);
 	OnRenderPlayer();
 	return true;
@@ -622,7 +701,7 @@ bool cPlayer::OnRenderPlayerJumpStart()
 
 bool cPlayer::OnRenderPlayerJumpContinue()
 {
-	frame6_id = (frame6_val - frame6_val_last + 1);
+	nJumpFrame = app->Animation.GetFrame(nJumpAnimation);
 	OnRenderPlayer();
 	return true;
 }
@@ -635,49 +714,39 @@ bool cPlayer::OnRenderPlayerJumpStop() const
 
 bool cPlayer::OnRenderPlayer() const
 {
-	const bool isValidID = (1 <= frame6_id && frame6_id <= frame6_id_limit);
-	const bool isLeft = (IsLeftDirection());
-	const bool isJump = (IsPlayerJumping()) && (isValidID);
-	const std::string froggy_state = std::string(isJump ? "_jump" : "");
-	const std::string froggy_direction = std::string(isLeft ? "_left" : "");
-	const std::string froggy_id = (isJump ? std::to_string(frame6_id) : "");
-	const std::string froggy_name = "froggy" + froggy_state + froggy_direction + froggy_id;
-	const auto froggy = cAssetManager::GetInstance().GetSprite(froggy_name);
+	TRACE_FUNCTION();
+	const int nSpriteIndex = GetSpriteIndex();
+	const auto froggy = arrSprites[nSpriteIndex];
 	if (froggy == nullptr) {
-		std::cerr << "WTF, cant found " << froggy_name << std::endl;
+		std::cerr << "WTF, cant found " << GetSpriteName(nSpriteIndex) << std::endl;
 	}
 
 	app->SetPixelMode(app::Pixel::MASK);
 	const float nCellSize = static_cast<float>(app->nCellSize);
-	const int32_t frogXPosition = static_cast<int32_t>(fFrogAnimPosX * nCellSize);
-	const int32_t frogYPosition = static_cast<int32_t>(fFrogAnimPosY * nCellSize);
+	const float fAlpha = app->GetRenderAlpha();
+	const float fRenderPosX = fFrogPrevAnimPosX + (fFrogAnimPosX - fFrogPrevAnimPosX) * fAlpha;
+	const float fRenderPosY = fFrogPrevAnimPosY + (fFrogAnimPosY - fFrogPrevAnimPosY) * fAlpha;
+	const int32_t frogXPosition = static_cast<int32_t>(fRenderPosX * nCellSize);
+	const int32_t frogYPosition = static_cast<int32_t>(fRenderPosY * nCellSize);
 	app->DrawSprite(frogXPosition, frogYPosition, froggy);
 	app->SetPixelMode(app::Pixel::NORMAL);
 	return true;
 }
 
-bool cPlayer::OnRenderPlayerDeath()
+bool cPlayer::OnRenderPlayerDeath(const int nFrame) const
 {
-	for (int id = 1; id <= 6; ++id) {
-		const std::string froggy_name = "froggy_death" + std::to_string(id);;
-		const auto froggy = cAssetManager::GetInstance().GetSprite(froggy_name);
-		if (froggy == nullptr) {
-			std::cerr << "WTF, cant found \"" << froggy_name << ".png\"" << std::endl;
-		}
-
-		const float nCellSize = static_cast<float>(app->nCellSize);
-		const int32_t frogXPosition = static_cast<int32_t>(GetPlayerAnimationPositionX() * nCellSize);
-		const int32_t frogYPosition = static_cast<int32_t>(GetPlayerAnimationPositionY() * nCellSize);
-		app->DrawAllLanes();
-		app->SetPixelMode(app::Pixel::MASK);
-		app->DrawSprite(frogXPosition, frogYPosition, froggy);
-		app->SetPixelMode(app::Pixel::NORMAL);
-		app->DrawStatusBar();
-
-		app->RenderTexture();
-		Sleep(100);
+	TRACE_FUNCTION();
+	const auto froggy = app->Animation.GetFrameSprite(nDeathAnimation, nFrame);
+	if (froggy == nullptr) {
+		std::cerr << "WTF, cant found \"froggy_death" << nFrame << ".png\"" << std::endl;
 	}
-	Reset();
+
+	app->SetPixelMode(app::Pixel::MASK);
+	const float nCellSize = static_cast<float>(app->nCellSize);
+	const int32_t frogXPosition = static_cast<int32_t>(GetPlayerAnimationPositionX() * nCellSize);
+	const int32_t frogYPosition = static_cast<int32_t>(GetPlayerAnimationPositionY() * nCellSize);
+	app->DrawSprite(frogXPosition, frogYPosition, froggy);
+	app->SetPixelMode(app::Pixel::NORMAL);
 	return true;
 }
 
@@ -685,8 +754,17 @@ bool cPlayer::OnRenderPlayerDeath()
 ///////////////////////////////////////// LOGIC-RENDER CONTROL /////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief Keep the current animation position as the previous simulation state
+bool cPlayer::OnBeginUpdate()
+{
+	fFrogPrevAnimPosX = fFrogAnimPosX;
+	fFrogPrevAnimPosY = fFrogAnimPosY;
+	return true;
+}
+
 bool cPlayer::OnPlayerMove()
 {
+	TRACE_FUNCTION();
 	if (IsPlayerIdling()) {
 		if (app->IsMoveLeft()) {
 			SetAnimation(JUMP);
@@ -705,7 +783,8 @@ bool cPlayer::OnPlayerMove()
 			SetDirection(IsLeftDirection() ? LEFT_DOWN : RIGHT_DOWN);
 		}
 
-		if (IsPlayerJumping()) {
+		if (IsPlayerJumping()) { // First frame reacting to the move input
+			app->MarkInputReaction();
 			OnRenderPlayerJumpStart();
 		}
 		else {
@@ -725,20 +804,6 @@ bool cPlayer::OnPlayerMove()
 	return true;
 }
 
-bool cPlayer::OnUpdateFrame(float fTickTime)
-{
-	frame4_id = static_cast<int>(std::floor(fTickTime / 0.15f)) % frame4_id_limit + 1;
-	frame6_val = static_cast<int>(std::floor(fTickTime / 0.03125f));
-	return true;
-}
-
-bool cPlayer::AddExtraFrame(int nExtra)
-{
-	frame6_val_last += nExtra;
-	frame6_val_cur += nExtra;
-	return true;
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////// END OF FILE ///////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
@@ -1,10 +1,13 @@
 #ifndef C_PLAYER_H
 #define C_PLAYER_H
 
+#include <array>
 #include <string>
+#include "cAnimationClock.h"
+#include "gSpriteMask.h"
 #include "uAppConst.h"
 class cApp;
-class cZone;
+class cCollisionQuery;
 
 /**
  * @file cPlayer.h
@@ -41,21 +44,24 @@ private:
 	float fFrogAnimPosY;
 	float fFrogLogicPosX;
 	float fFrogLogicPosY;
+	float fFrogPrevAnimPosX; ///< Animation position X at the previous simulation step (for interpolation)
+	float fFrogPrevAnimPosY; ///< Animation position Y at the previous simulation step (for interpolation)
 
 private:
-	frame_t frame4_id;
-	frame_t frame4_id_limit;
-	frame_t frame6_id;
-	frame_t frame6_id_safe; // the smaller the stricter
-	frame_t frame6_id_limit; /// ehmmm, unneeded to separate to another struct for now
-	frame_t frame6_val;
-	frame_t frame6_val_cur;
-	frame_t frame6_val_last;
+	AnimationId nJumpAnimation = -1;  ///< Jump animation on the app animation clock (ONCE, landing past its last frame)
+	AnimationId nDeathAnimation = -1; ///< Death animation on the app animation clock (frame sprites only)
+	frame_t nJumpFrame; ///< Jump frame drawn by the last move (0 if idle since reset)
+	frame_t nJumpTick;  ///< Clock tick of the last jump step (the frog moves once per jump frame)
 
 private:
 	Direction eDirection;
 	Animation eAnimation;
 
+private:
+	static constexpr int SPRITE_VARIANTS = 1 + app_const::JUMP_FRAMES; ///< Sprites per direction (idle, then the jump frames)
+	std::array<const app::Sprite*, 2 * SPRITE_VARIANTS> arrSprites{}; ///< Handles of player sprites (key: sprite index)
+	std::array<app::SpriteMask, 2 * SPRITE_VARIANTS> arrMasks; ///< Opacity masks of player sprites (key: sprite index)
+
 private:
 	cApp* app;
 
@@ -71,6 +77,7 @@ public: // Reseters
 	void ResetVelocity();
 	void Reset();
 	void SetupTarget(cApp* app);
+	void LoadSprites();
 
 public: // Checkers
 	bool IsExactDirection(Direction eCompare) const;
@@ -90,6 +97,7 @@ public: // Collision Detection
 	bool IsHitBottomLeft() const;
 	bool IsHitBottomRight() const;
 	bool IsHit() const;
+	bool IsHitPixel() const;
 	bool IsBlockedTopLeft() const;
 	bool IsBlockedTopRight() const;
 	bool IsBlockedBottomLeft() const;
@@ -105,8 +113,9 @@ public: // Validators
 public: // Getters
 	Direction GetDirection() const;
 	Animation GetAnimation() const;
-	int GetFrameID(frame_t frame) const;
-	std::string ShowFrameID(frame_t frame) const;
+	int GetSpriteIndex() const;
+	static std::string GetSpriteName(int nSpriteIndex);
+	const app::SpriteMask& GetPlayerMask() const;
 	float GetPlayerAnimationPositionX() const;
 	float GetPlayerAnimationPositionY() const;
 	float GetPlayerLogicPositionX() const;
@@ -140,6 +149,8 @@ public: // Movements
 	bool PlayerPlatformMoveX(float fFactorX, int nStep = 16);
 	bool PlayerPlatformMoveY(float fFactorY, int nStep = 16);
 	bool PlayerPlatformMove(float fFactorX, float fFactorY, float fFactorScale = 1, int nStep = 16);
+	bool PlayerMoveToSafeOffset(int nDirection, int nMaxOffset);
+	int GetFreeSteps(float fOffsetX, float fOffsetY, int nStep) const;
 
 public: // Logic Updater
 	bool OnUpdatePlayerLane();
@@ -152,12 +163,11 @@ public: // Player Renderer
 	bool OnRenderPlayerJumpContinue();
 	bool OnRenderPlayerJumpStop() const;
 	bool OnRenderPlayer() const;
-	bool OnRenderPlayerDeath();
+	bool OnRenderPlayerDeath(int nFrame) const;
 
 public: // Logic-Render Control
+	bool OnBeginUpdate();
 	bool OnPlayerMove();
-	bool OnUpdateFrame(float fTickTime);
-	bool AddExtraFrame(int nExtra = 1);
 };
 
 #endif // C_PLAYER_H
\ No newline at end of file
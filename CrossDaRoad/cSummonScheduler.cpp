@@ -0,0 +1,136 @@
+#include "cSummonScheduler.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * @file cSummonScheduler.cpp
+ *
+ * @brief Contains summon scheduler class implementation
+ *
+ * This file implements summon scheduler class. Each summoning cell waits an exponentially distributed time
+ * (rate = chance per second) before showing its summoned tile for a duration, then rests for a cooldown.
+ * Only cells whose activation has ended are visited on update, so the cost per frame does not depend on
+ * the number of visible cells nor on the frame rate.
+**/
+
+/// @brief Order events by time, for a min-heap
+bool cSummonScheduler::Event::operator>(const Event& other) const
+{
+	return fTime > other.fTime;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// CONSTRUCTORS & DESTRUCTOR ////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Default constructor
+cSummonScheduler::cSummonScheduler()
+{
+	nLaneCount = 0;
+	nLaneWidth = 0;
+	bStarted = false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// RESET & UPDATE ////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Prepare schedule for a newly loaded map, first spawns are sampled on the next update
+/// @param runtime Compiled map to schedule
+/// @param stream Random stream of the map, split into one independent stream per lane
+void cSummonScheduler::Reset(const cMapRuntime& runtime, const app::RandomStream& stream)
+{
+	nLaneCount = runtime.GetLaneCount();
+	nLaneWidth = runtime.GetLaneWidth();
+	const size_t nCellCount = static_cast<size_t>(nLaneCount) * nLaneWidth;
+	vecStartTimes.assign(nCellCount, std::numeric_limits<float>::infinity());
+	vecEndTimes.assign(nCellCount, -std::numeric_limits<float>::infinity());
+	vecEvents.clear();
+	vecLaneStreams.resize(nLaneCount);
+	for (int nRow = 0; nRow < nLaneCount; nRow++) {
+		vecLaneStreams[nRow] = stream.Split(static_cast<uint64_t>(nRow));
+	}
+	bStarted = false;
+}
+/// @brief Advance schedule to current time, rescheduling every activation that has ended
+/// @param runtime Compiled map being scheduled (the one given to Reset)
+/// @param fCurrentTime Current game time (in seconds)
+void cSummonScheduler::Update(const cMapRuntime& runtime, const float fCurrentTime)
+{
+	if (!bStarted) {
+		for (int nRow = 0; nRow < nLaneCount; nRow++) {
+			const uint8_t* pLaneTiles = runtime.GetLaneTiles(nRow);
+			for (int nCol = 0; nCol < nLaneWidth; nCol++) {
+				const MapTile& tile = runtime.GetTile(pLaneTiles[nCol]);
+				if (tile.IsSummon()) {
+					Schedule(tile, static_cast<uint32_t>(nRow * nLaneWidth + nCol), fCurrentTime);
+				}
+			}
+		}
+		bStarted = true;
+	}
+
+	while (!vecEvents.empty() && vecEvents.front().fTime < fCurrentTime) {
+		std::pop_heap(vecEvents.begin(), vecEvents.end(), std::greater<Event>());
+		const uint32_t uCell = vecEvents.back().uCell;
+		vecEvents.pop_back();
+
+		const int nRow = static_cast<int>(uCell) / nLaneWidth;
+		const int nCol = static_cast<int>(uCell) % nLaneWidth;
+		const MapTile& tile = runtime.GetTile(runtime.GetLaneTile(nRow, nCol));
+		Schedule(tile, uCell, vecEndTimes[uCell] + tile.fCooldown);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// GETTERS ///////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Check if the summoned tile of a cell is shown
+/// @param nRow Index of the lane
+/// @param nCol Index of the tile in lane (wrapped around lane width)
+/// @param fCurrentTime Current game time (in seconds)
+bool cSummonScheduler::IsActive(const int nRow, const int nCol, const float fCurrentTime) const
+{
+	if (nRow < 0 || nRow >= nLaneCount || nLaneWidth <= 0) {
+		return false;
+	}
+	int nWrapped = nCol % nLaneWidth;
+	if (nWrapped < 0) {
+		nWrapped += nLaneWidth;
+	}
+	const size_t uCell = static_cast<size_t>(nRow) * nLaneWidth + nWrapped;
+	return vecStartTimes[uCell] <= fCurrentTime && fCurrentTime <= vecEndTimes[uCell];
+}
+/// @brief Getter for number of cells waiting for their next activation
+int cSummonScheduler::GetScheduledCount() const
+{
+	return static_cast<int>(vecEvents.size());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////// SCHEDULERS ////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Sample the next activation of a cell
+/// @param tile Summoning tile of the cell
+/// @param uCell Cell index
+/// @param fFromTime Earliest time the cell may be activated again (in seconds)
+void cSummonScheduler::Schedule(const MapTile& tile, const uint32_t uCell, const float fFromTime)
+{
+	if (!tile.IsSummon()) {
+		vecStartTimes[uCell] = std::numeric_limits<float>::infinity();
+		return;
+	}
+	app::RandomStream& stream = vecLaneStreams[uCell / nLaneWidth];
+	const float fStartTime = fFromTime + stream.Exponential(tile.fChance / 100.0f);
+	vecStartTimes[uCell] = fStartTime;
+	vecEndTimes[uCell] = fStartTime + tile.fDuration;
+	vecEvents.push_back({ vecEndTimes[uCell], uCell });
+	std::push_heap(vecEvents.begin(), vecEvents.end(), std::greater<Event>());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////// END OF FILE /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
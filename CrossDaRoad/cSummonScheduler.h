@@ -0,0 +1,55 @@
+#ifndef C_SUMMON_SCHEDULER_H
+#define C_SUMMON_SCHEDULER_H
+
+#include "cMapRuntime.h"
+#include "gRandom.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file cSummonScheduler.h
+ *
+ * @brief Contains summon scheduler class
+ *
+ * This file contains summon scheduler class that decides when summoning tiles show their summoned tile.
+**/
+
+/// @brief Class for scheduling summoned tiles of a map, independent of frame rate
+class cSummonScheduler
+{
+private:
+	/// @brief End of an activation of a summoning cell
+	struct Event
+	{
+		float fTime;    ///< Time when the activation ends (in seconds)
+		uint32_t uCell; ///< Cell index (row * lane width + column)
+
+		bool operator>(const Event& other) const;
+	};
+
+private:
+	std::vector<float> vecStartTimes; ///< Start time of the current or next activation of each cell (+oo if never)
+	std::vector<float> vecEndTimes;   ///< End time of the current or next activation of each cell
+	std::vector<Event> vecEvents;     ///< Min-heap of pending activation ends (earliest first)
+	std::vector<app::RandomStream> vecLaneStreams; ///< Random stream of spawn times of each lane
+	int nLaneCount; ///< Number of lanes of the scheduled map
+	int nLaneWidth; ///< Number of tiles per lane of the scheduled map
+	bool bStarted;  ///< false until the first update after a reset
+
+public: // Constructors & Destructor
+	cSummonScheduler();
+	~cSummonScheduler() = default;
+
+public: // Reset & Update
+	void Reset(const cMapRuntime& runtime, const app::RandomStream& stream);
+	void Update(const cMapRuntime& runtime, float fCurrentTime);
+
+public: // Getters
+	bool IsActive(int nRow, int nCol, float fCurrentTime) const;
+	int GetScheduledCount() const;
+
+private:
+	void Schedule(const MapTile& tile, uint32_t uCell, float fFromTime);
+};
+
+#endif // C_SUMMON_SCHEDULER_H
@@ -59,6 +59,13 @@ namespace engine
 	constexpr const wchar_t* ENGINE_WIDE_NAME = L"GAME_ENGINE";
 	constexpr const char* ICON_FILE_PATH = "data/icons/icon.ico";
 	constexpr const char* FAVICON_FILE_PATH = "data/icons/favicon.ico";
+	constexpr const char* PROFILE_CSV_FILE_PATH = "profile.csv";   ///< Frame profile dump (one row per frame)
+	constexpr const char* PROFILE_JSON_FILE_PATH = "profile.json"; ///< Frame profile dump (statistics and frames)
+	constexpr const char* TRACE_FILE_PATH = "trace.json";           ///< Trace zones dump (Chrome trace-event format)
+	constexpr int PAUSE_WAKE_INTERVAL = 250;                        ///< Longest wait for input while paused (milliseconds)
+	constexpr int TITLE_UPDATE_INTERVAL = 250;                      ///< Shortest delay between two window title updates (milliseconds)
+	constexpr int INPUT_QUEUE_SIZE = 256;                           ///< Capacity of the input event queue (window thread to engine thread)
+	constexpr int REPLAY_HASH_INTERVAL = 120;                       ///< Keyboard samples between two state hashes of a replay
 
 	/// @brief Enumeration of ticks in the game engine (for event handling)
 	enum Tick
@@ -95,6 +102,8 @@ namespace engine
 		// Special Events
 		ON_PAUSE_EVENT,
 		ON_UNPAUSE_EVENT,
+
+		TICK_COUNT, ///< Number of ticks (not an event)
 	};
 }
 
@@ -0,0 +1,231 @@
+#include "gFramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+#ifdef _WIN32
+#pragma comment(lib, "winmm.lib")
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#else
+#include <thread>
+#endif
+
+/**
+ * @file gFramePacer.cpp
+ *
+ * @brief Contains frame jitter statistics struct and frame pacer class implementation
+ *
+ * This file implements the frame pacer. Waiting is split in two parts: an OS sleep until the deadline
+ * minus a slack (waitable timer on Windows, clock_nanosleep with TIMER_ABSTIME on Linux), then a short
+ * spin until the deadline. The slack follows the observed oversleep of the OS, so the spin only covers
+ * the timer inaccuracy. Deadlines are absolute, so a late wake up does not shift the following frames.
+**/
+
+namespace app
+{
+	using namespace std::chrono_literals;
+
+	static constexpr std::chrono::nanoseconds MIN_SLACK = 100us;   ///< Smallest spinning slack
+	static constexpr std::chrono::nanoseconds MAX_SLACK = 4000us;  ///< Largest spinning slack
+	static constexpr std::chrono::nanoseconds SLACK_STEP = 10us;   ///< Adaptation step of the slack
+#ifdef _WIN32
+	static constexpr std::chrono::nanoseconds START_SLACK = 1500us; ///< Initial slack (waitable timers)
+#else
+	static constexpr std::chrono::nanoseconds START_SLACK = 250us;  ///< Initial slack (nanosleep)
+#endif
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////// FRAME JITTER /////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for the jitter report as a string
+	std::string FrameJitter::Show() const
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(1);
+		output << "[Pacer: " << uFrames << " frames, " << uMissed << " missed";
+		output << ", interval " << fIntervalMean << " +- " << fIntervalStdDev << " us";
+		output << ", wake late " << fLateMean << " us (max " << fLateMax << " us)";
+		output << ", slack " << fSlack << " us]";
+		return output.str();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////// FRAME PACER //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, create the OS timer
+	FramePacer::FramePacer()
+	{
+		pTimer = nullptr;
+		bTimerPeriod = false;
+#ifdef _WIN32
+		pTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (!pTimer) { // Before Windows 10 (1803): classic timer, raise the system timer resolution
+			pTimer = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+			bTimerPeriod = (timeBeginPeriod(1) == TIMERR_NOERROR);
+		}
+#endif
+		nsSlack = START_SLACK;
+		Reset();
+		ResetJitter();
+	}
+
+	/// @brief Destructor, release the OS timer
+	FramePacer::~FramePacer()
+	{
+#ifdef _WIN32
+		if (pTimer) {
+			CloseHandle(static_cast<HANDLE>(pTimer));
+		}
+		if (bTimerPeriod) {
+			timeEndPeriod(1);
+		}
+#endif
+	}
+
+	/// @brief Restart the schedule, the next frame is paced from now
+	void FramePacer::Reset()
+	{
+		bStarted = false;
+		tDeadline = clock_t::now();
+		tLastFrame = tDeadline;
+	}
+
+	/// @brief Wait for the deadline of the next frame
+	/// @param nPeriod Frame period in microseconds (0: do not wait)
+	/// @return true if the frame was on time, false if it was already late
+	bool FramePacer::WaitNextFrame(const int32_t nPeriod)
+	{
+		const nanoseconds_t nsPeriod = std::chrono::microseconds(std::max(nPeriod, 0));
+		time_point_t tNow = clock_t::now();
+		if (!bStarted) {
+			bStarted = true;
+			tDeadline = tNow;
+			tLastFrame = tNow;
+		}
+
+		tDeadline += nsPeriod;
+		bool bOnTime = true;
+		if (tNow >= tDeadline) { // The frame took longer than its period
+			bOnTime = nsPeriod.count() == 0;
+			if (tNow - tDeadline > nsPeriod) { // More than one frame behind: drop the backlog
+				tDeadline = tNow;
+			}
+		}
+		else {
+			WaitUntil(tDeadline);
+			tNow = clock_t::now();
+		}
+
+		const double fInterval = std::chrono::duration<double, std::micro>(tNow - tLastFrame).count();
+		const double fLate = std::chrono::duration<double, std::micro>(tNow - tDeadline).count();
+		tLastFrame = tNow;
+		uFrames++;
+		uMissed += bOnTime ? 0 : 1;
+		fIntervalSum += fInterval;
+		fIntervalSqSum += fInterval * fInterval;
+		fLateSum += std::max(fLate, 0.0);
+		fLateMax = std::max(fLateMax, fLate);
+		return bOnTime;
+	}
+
+	/// @brief Wait until an absolute time: sleep most of the time, then spin the slack
+	/// @param tWake The time to wake up
+	void FramePacer::WaitUntil(const time_point_t tWake)
+	{
+		const time_point_t tSleep = tWake - nsSlack;
+		if (clock_t::now() < tSleep) {
+			SleepUntil(tSleep);
+			const time_point_t tWoken = clock_t::now();
+			AdaptSlack(tWoken > tSleep ? tWoken - tSleep : nanoseconds_t::zero());
+		}
+		while (clock_t::now() < tWake) {
+			// Spin the remaining slack, the OS timer is not precise enough for it
+		}
+	}
+
+	/// @brief Sleep with the OS high-resolution timer, may oversleep by the timer inaccuracy
+	/// @param tWake The time to wake up
+	void FramePacer::SleepUntil(const time_point_t tWake)
+	{
+#ifdef _WIN32
+		const nanoseconds_t nsLeft = tWake - clock_t::now();
+		if (nsLeft <= nanoseconds_t::zero()) {
+			return;
+		}
+		if (pTimer) {
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -static_cast<LONGLONG>(nsLeft.count() / 100); // relative, in 100 ns units
+			if (SetWaitableTimer(static_cast<HANDLE>(pTimer), &dueTime, 0, nullptr, nullptr, FALSE)) {
+				WaitForSingleObject(static_cast<HANDLE>(pTimer), INFINITE);
+				return;
+			}
+		}
+		Sleep(static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(nsLeft).count()));
+#elif defined(__linux__)
+		// steady_clock counts from the CLOCK_MONOTONIC epoch
+		const int64_t nWake = std::chrono::duration_cast<nanoseconds_t>(tWake.time_since_epoch()).count();
+		timespec wakeTime;
+		wakeTime.tv_sec = static_cast<time_t>(nWake / 1000000000);
+		wakeTime.tv_nsec = static_cast<long>(nWake % 1000000000);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, nullptr) == EINTR) {
+			// Interrupted by a signal, sleep again until the same absolute time
+		}
+#else
+		std::this_thread::sleep_until(tWake);
+#endif
+	}
+
+	/// @brief Track the 90th percentile of the OS oversleep (stochastic quantile estimate)
+	/// @details Rare long preemptions are ignored on purpose: spinning longer does not prevent them,
+	/// it only burns the time slice, so the slack covers the usual timer inaccuracy only.
+	/// @param nsOversleep Delay between the requested and the actual wake up
+	void FramePacer::AdaptSlack(const nanoseconds_t nsOversleep)
+	{
+		const nanoseconds_t nsTarget = nsOversleep + nsOversleep / 4 + 50us;
+		if (nsTarget > nsSlack) {
+			nsSlack += 9 * SLACK_STEP;
+		}
+		else {
+			nsSlack -= SLACK_STEP;
+		}
+		nsSlack = std::clamp(nsSlack, MIN_SLACK, MAX_SLACK);
+	}
+
+	/// @brief Reset the frame timing statistics
+	void FramePacer::ResetJitter()
+	{
+		uFrames = 0;
+		uMissed = 0;
+		fIntervalSum = 0;
+		fIntervalSqSum = 0;
+		fLateSum = 0;
+		fLateMax = 0;
+	}
+
+	/// @brief Getter for the frame timing statistics since the last reset
+	FrameJitter FramePacer::GetJitter() const
+	{
+		FrameJitter jitter{};
+		jitter.uFrames = uFrames;
+		jitter.uMissed = uMissed;
+		jitter.fSlack = std::chrono::duration<double, std::micro>(nsSlack).count();
+		if (uFrames > 0) {
+			const double fFrames = static_cast<double>(uFrames);
+			jitter.fIntervalMean = fIntervalSum / fFrames;
+			const double fVariance = fIntervalSqSum / fFrames - jitter.fIntervalMean * jitter.fIntervalMean;
+			jitter.fIntervalStdDev = std::sqrt(std::max(fVariance, 0.0));
+			jitter.fLateMean = fLateSum / fFrames;
+			jitter.fLateMax = fLateMax;
+		}
+		return jitter;
+	}
+} // namespace app
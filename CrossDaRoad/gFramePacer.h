@@ -0,0 +1,78 @@
+#ifndef G_FRAME_PACER_H
+#define G_FRAME_PACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file gFramePacer.h
+ *
+ * @brief Contains frame jitter statistics struct and frame pacer class
+ *
+ * This file contains the frame pacer of the engine loop. Frames are scheduled on absolute deadlines,
+ * the bulk of each wait is an OS high-resolution sleep and only the last slack is spent spinning.
+**/
+
+namespace app
+{
+	/// @brief Frame timing statistics collected by the frame pacer (all durations in microseconds)
+	struct FrameJitter
+	{
+		uint64_t uFrames;       ///< Number of paced frames
+		uint64_t uMissed;       ///< Number of frames which were already late before waiting
+		double fIntervalMean;   ///< Mean interval between two consecutive frames
+		double fIntervalStdDev; ///< Standard deviation of the frame interval (the jitter)
+		double fLateMean;       ///< Mean delay between the deadline and the actual wake up
+		double fLateMax;        ///< Worst delay between the deadline and the actual wake up
+		double fSlack;          ///< Current spinning slack before the deadline
+
+		std::string Show() const;
+	};
+
+	/// @brief Hybrid sleep-then-spin frame pacer with absolute deadlines
+	class FramePacer
+	{
+	public:
+		using clock_t = std::chrono::steady_clock;   ///< Monotonic clock of all deadlines
+		using time_point_t = clock_t::time_point;    ///< Absolute time on the monotonic clock
+		using nanoseconds_t = std::chrono::nanoseconds; ///< Duration type of the pacer
+
+	private:
+		time_point_t tDeadline;   ///< Deadline of the next frame
+		time_point_t tLastFrame;  ///< Wake up time of the last frame
+		nanoseconds_t nsSlack;    ///< Time spent spinning before the deadline (adapted to OS oversleep)
+		bool bStarted;            ///< If the first deadline was set
+		void* pTimer;             ///< Waitable timer handle (Windows only, nullptr elsewhere)
+		bool bTimerPeriod;        ///< If the system timer resolution was raised (Windows only)
+
+	private: // Statistics
+		uint64_t uFrames;         ///< Number of measured frames
+		uint64_t uMissed;         ///< Number of frames late before waiting
+		double fIntervalSum;      ///< Sum of frame intervals (microseconds)
+		double fIntervalSqSum;    ///< Sum of squared frame intervals
+		double fLateSum;          ///< Sum of wake up delays (microseconds)
+		double fLateMax;          ///< Worst wake up delay (microseconds)
+
+	public: // Constructors & Destructor
+		FramePacer();
+		~FramePacer();
+		FramePacer(const FramePacer&) = delete;
+		FramePacer& operator=(const FramePacer&) = delete;
+
+	public: // Pacing
+		void Reset();
+		bool WaitNextFrame(int32_t nPeriod);
+		void WaitUntil(time_point_t tWake);
+
+	public: // Statistics
+		void ResetJitter();
+		FrameJitter GetJitter() const;
+
+	private:
+		void SleepUntil(time_point_t tWake);
+		void AdaptSlack(nanoseconds_t nsOversleep);
+	};
+} // namespace app
+
+#endif // G_FRAME_PACER_H
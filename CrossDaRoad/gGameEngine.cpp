@@ -8,6 +8,8 @@
 
 #include "gConst.h"
 #include "gUtils.h"
+#include <algorithm>
+#include <bitset>
 #include <iostream>
 
 /**
@@ -118,6 +120,33 @@ namespace app
 		StartEngineThread();
 		return engine::SUCCESS;
 	}
+
+	/// @brief Run the game on the calling thread without window: scripted input, no texture upload and
+	/// (on virtual time) no frame pacing, until the frame limit, the stop condition or the game stops.
+	/// @param options The frame limit, clock, input script and stop condition of the run.
+	/// @return The result code.
+	engine::Code GameEngine::StartHeadless(HeadlessOptions options)
+	{
+		if (!texture.GetDefaultDrawTarget()) {
+			std::cerr << "Error: The engine must be constructed before running headless." << std::endl;
+			return engine::FAILURE;
+		}
+
+		TRACE_THREAD("Headless");
+		if (options.bFixedSeed) {
+			SetRandomSeed(options.uSeed);
+		}
+		if (options.bProfile) { // Every frame is kept, the statistics cover the whole run
+			profiler.SetCapacity(std::max<size_t>(static_cast<size_t>(options.uFrames), FrameProfiler::DEFAULT_CAPACITY));
+			profiler.SetEnabled(true);
+		}
+		keyboard.SetFocus(true);
+		headless.Start(std::move(options));
+		UpdateEngineEvent();
+		headless.Stop();
+		std::cout << GetHeadlessSummary().Show() << std::endl;
+		return engine::SUCCESS;
+	}
 } // namespace app
 
 /**
@@ -207,6 +236,15 @@ namespace app
 		// actions If cleanup is successful, return true; otherwise, return false.
 		return true;
 	}
+
+	/// @brief Called to hash the game state of a replay (see HashState), at the same keyboard sample
+	/// of the recording and of the replay.
+	/// @return The hash of everything the input changes in the game, 0 by default.
+	uint64_t GameEngine::OnStateHashEvent()
+	{
+		// TODO: Hash the game state with a StateHasher (positions, level, score, menus, ...)
+		return 0;
+	}
 } // namespace app
 
 /**
@@ -363,6 +401,19 @@ namespace app
 	{
 		return texture.Clear(pixel);
 	}
+
+	/// @brief Copy the drawing target into a sprite of the same size (e.g. to keep a frame and draw it back later).
+	/// @param pFrame The sprite receiving the pixels.
+	/// @return True if the pixels were copied, false if the sprite is missing or has another size.
+	bool GameEngine::CaptureFrame(Sprite* pFrame) const
+	{
+		const Sprite* pTarget = texture.GetDrawTarget();
+		if (!pFrame || !pTarget || pFrame->Width() != pTarget->Width() || pFrame->Height() != pTarget->Height()) {
+			return false;
+		}
+		std::copy_n(pTarget->GetData(), texture.GetDrawTargetSize(), pFrame->GetData());
+		return true;
+	}
 } // namespace app
 
 /**
@@ -385,6 +436,323 @@ namespace app
 	{
 		return frame.SetDelay(eFrameDelay);
 	}
+
+	/// @brief Sets the duration of one simulation step, OnUpdateEvent is then called at this fixed rate.
+	/// @param fTimeStep The step in seconds (e.g. 1/120), 0 to update once per rendered frame.
+	/// @return True if the step is valid.
+	bool GameEngine::SetFixedTimeStep(const float fTimeStep)
+	{
+		return simulation.SetTimeStep(fTimeStep);
+	}
+
+	/// @brief Retrieves the duration of one simulation step (0 if the update rate follows the frame rate).
+	float GameEngine::GetFixedTimeStep() const
+	{
+		return simulation.GetTimeStep();
+	}
+
+	/// @brief Retrieves the interpolation factor between the last two simulation states, for rendering.
+	/// @return 0 at the previous state, 1 at the current state (always 1 without fixed step).
+	float GameEngine::GetRenderAlpha() const
+	{
+		return simulation.GetAlpha();
+	}
+
+	/// @brief Runs the game loop on its own thread, frames are presented by the engine thread.
+	/// @param bEnable True to use a simulation thread (applied when the engine loop starts, e.g. from OnCreateEvent).
+	/// @return Always return true on default
+	bool GameEngine::SetSimulationThread(const bool bEnable)
+	{
+		bSimulationThread = bEnable;
+		return true;
+	}
+
+	/// @brief Checks if the game loop runs on its own simulation thread.
+	bool GameEngine::IsSimulationThread() const
+	{
+		return bSimulationThread;
+	}
+
+	/// @brief Retrieves the frame timing statistics (interval jitter, wake up delay) of the frame pacer.
+	FrameJitter GameEngine::GetFrameJitter() const
+	{
+		return frame.GetJitter();
+	}
+
+	/// @brief Lets the frame delay follow the measured frame work, between two delays of the FrameDelay ladder.
+	/// @param bEnable True to enable the governor (headless runs keep their delay).
+	/// @param eFastest The shortest frame delay the governor may pick.
+	/// @param eSlowest The longest frame delay the governor may pick, optional work is shed beyond it.
+	void GameEngine::SetFrameGovernor(const bool bEnable, const FrameDelay eFastest, const FrameDelay eSlowest)
+	{
+		governor.SetEnabled(bEnable, eFastest, eSlowest);
+	}
+
+	/// @brief Checks if the frame governor changes the frame delay.
+	bool GameEngine::IsFrameGovernor() const
+	{
+		return governor.IsEnabled();
+	}
+
+	/// @brief Checks if the frames overrun the slowest budget of the governor, optional work should then be skipped.
+	bool GameEngine::IsSheddingWork() const
+	{
+		return governor.IsShedding();
+	}
+
+	/// @brief Retrieves how long the input events waited between the window thread and the engine loop.
+	InputLatency GameEngine::GetInputLatency() const
+	{
+		return inputLatency;
+	}
+
+	/// @brief Tells that the current update reacts to the input (e.g. the Player starts a move): the
+	/// frame composed next closes the input-to-present latency of the newest applied input event.
+	void GameEngine::MarkInputReaction()
+	{
+		if (!pendingInput.IsValid()) { // Already reacted to, or no input event (e.g. replay)
+			return;
+		}
+		reactionTag = pendingInput;
+		reactionTag.nReacted = InputEvent::GetTimestamp();
+		pendingInput = LatencyTag();
+	}
+
+	/// @brief Retrieves the input-to-present latency histogram of the reactions marked by MarkInputReaction.
+	PresentLatency GameEngine::GetPresentLatency() const
+	{
+		return presentLatency;
+	}
+} // namespace app
+
+/**
+ * @namespace app
+ * @brief Profiling
+ **/
+namespace app
+{
+	/// @brief Enables or disables the per-phase timing of the engine loop.
+	/// @param bEnable True to record the phase durations of each frame.
+	void GameEngine::SetProfiling(const bool bEnable)
+	{
+		profiler.SetEnabled(bEnable);
+	}
+
+	/// @brief Retrieves min, mean, p50, p95, p99 and max of a phase over the last recorded frames.
+	/// @param ePhase The phase of the engine loop.
+	/// @return The statistics (in milliseconds).
+	FrameProfiler::PhaseStats GameEngine::GetProfileStats(const FrameProfiler::Phase ePhase) const
+	{
+		return profiler.GetStats(ePhase);
+	}
+
+	/// @brief Retrieves the phase durations of a recorded frame.
+	/// @param uAge 0 for the last recorded frame, 1 for the one before, ...
+	/// @return The durations of all phases (in milliseconds).
+	FrameProfiler::FrameTimes GameEngine::GetProfileFrame(const size_t uAge) const
+	{
+		return profiler.GetFrame(uAge);
+	}
+
+	/// @brief Writes the recorded frames to the profile CSV and JSON files.
+	/// @return True if both files were written.
+	bool GameEngine::DumpProfile() const
+	{
+		const bool bCSV = profiler.DumpCSV(engine::PROFILE_CSV_FILE_PATH);
+		const bool bJSON = profiler.DumpJSON(engine::PROFILE_JSON_FILE_PATH);
+		return bCSV && bJSON;
+	}
+
+	/// @brief Shows or hides the performance overlay (FPS, frame time graph, phase bars, draw counts, memory).
+	/// @param bShow True to draw the overlay on each presented frame.
+	void GameEngine::SetOverlay(const bool bShow)
+	{
+		overlay.SetVisible(bShow);
+	}
+
+	/// @brief Shows the performance overlay if hidden, hides it otherwise.
+	/// @return True if the overlay is now shown.
+	bool GameEngine::ToggleOverlay()
+	{
+		return overlay.Toggle();
+	}
+
+	/// @brief Checks if the performance overlay is shown.
+	bool GameEngine::IsOverlay() const
+	{
+		return overlay.IsVisible();
+	}
+
+	/// @brief Starts a new trace session (the zones of the previous one are dropped) or stops recording.
+	/// @param bEnable True to record the trace zones of all threads.
+	void GameEngine::SetTracing(const bool bEnable)
+	{
+		if (bEnable) {
+			app_trace::Start();
+		}
+		else {
+			app_trace::Stop();
+		}
+	}
+
+	/// @brief Checks if the trace zones are being recorded.
+	bool GameEngine::IsTracing() const
+	{
+		return app_trace::IsRecording();
+	}
+
+	/// @brief Writes the last trace session to the trace file (open it in chrome://tracing or ui.perfetto.dev).
+	/// @return True if the file was written.
+	bool GameEngine::DumpTrace() const
+	{
+		return app_trace::Export(engine::TRACE_FILE_PATH);
+	}
+} // namespace app
+
+/**
+ * @namespace app
+ * @brief Headless
+ **/
+namespace app
+{
+	/// @brief Checks if the engine runs without window (see StartHeadless).
+	bool GameEngine::IsHeadless() const
+	{
+		return headless.IsEnabled();
+	}
+
+	/// @brief Retrieves the current frame of the headless run (e.g. for a stop condition).
+	uint64_t GameEngine::GetHeadlessFrame() const
+	{
+		return headless.GetFrame();
+	}
+
+	/// @brief Retrieves the frames, input events, game time and wall time of the current or last headless run.
+	HeadlessSummary GameEngine::GetHeadlessSummary() const
+	{
+		HeadlessSummary summary = headless.GetSummary();
+		summary.uSeed = random.GetSeed();
+		summary.uFrameHash = HashFrame();
+		return summary;
+	}
+
+	/// @brief Hashes the pixels of the drawing target (64-bit FNV-1a over the pixel values), to compare runs of the same seed and script.
+	/// @return The hash, 0 without drawing target.
+	uint64_t GameEngine::HashFrame() const
+	{
+		const Sprite* pTarget = texture.GetDrawTarget();
+		if (!pTarget) {
+			return 0;
+		}
+		uint64_t uHash = 0xCBF29CE484222325ull;
+		const Pixel* pPixels = pTarget->GetData();
+		for (int32_t nIndex = 0; nIndex < texture.GetDrawTargetSize(); nIndex++) {
+			uHash = (uHash ^ pPixels[nIndex].n) * 0x100000001B3ull;
+		}
+		return uHash;
+	}
+} // namespace app
+
+/**
+ * @namespace app
+ * @brief Replay
+ **/
+namespace app
+{
+	/// @brief Records the key changes of the next session to a replay file, with the seed, the level
+	/// given by SetReplayLevel() and a state hash every few keyboard samples.
+	/// @param sFilePath The replay file to write when the session ends.
+	/// @param uHashInterval The keyboard samples between two state hashes (0: only the final hash).
+	/// @return True if the recording was requested.
+	bool GameEngine::RecordReplay(const std::string& sFilePath, const uint32_t uHashInterval)
+	{
+		recorder.Request(sFilePath, uHashInterval);
+		return !sFilePath.empty();
+	}
+
+	/// @brief Loads a replay file, played in the next session instead of the keyboard: the seed of the
+	/// recording is set at once, the game restores its level from GetReplayLevel() in OnCreateEvent().
+	/// @param sFilePath The replay file written by a recording.
+	/// @return True if the replay was loaded.
+	bool GameEngine::LoadReplay(const std::string& sFilePath)
+	{
+		if (!replay.Load(sFilePath)) {
+			return false;
+		}
+		SetRandomSeed(replay.GetHeader().uSeed);
+		nReplayLevel = replay.GetHeader().nLevel;
+		return true;
+	}
+
+	/// @brief Checks if the key changes of the session are recorded.
+	bool GameEngine::IsRecording() const
+	{
+		return recorder.IsRecording();
+	}
+
+	/// @brief Checks if the keyboard is fed by a replay.
+	bool GameEngine::IsReplaying() const
+	{
+		return replay.IsLoaded();
+	}
+
+	/// @brief Retrieves the starting level of the loaded replay (or the level given to SetReplayLevel).
+	int32_t GameEngine::GetReplayLevel() const
+	{
+		return nReplayLevel;
+	}
+
+	/// @brief Sets the starting level written to the recording (call it from OnCreateEvent).
+	/// @param nLevel The level the game starts at.
+	void GameEngine::SetReplayLevel(const int32_t nLevel)
+	{
+		nReplayLevel = nLevel;
+	}
+
+	/// @brief Retrieves the key changes, state hashes and result of the current or last replay, or of the last recording.
+	ReplaySummary GameEngine::GetReplaySummary() const
+	{
+		return replay.GetSummary().bReplay ? replay.GetSummary() : recorder.GetSummary();
+	}
+
+	/// @brief Hashes the state the input drives: the simulation clock, the seed and the game state (see OnStateHashEvent).
+	/// @return The hash, the same at the same keyboard sample of a recording and of its replay.
+	uint64_t GameEngine::HashState()
+	{
+		StateHasher hasher;
+		hasher.Add(simulation.GetTime()).Add(random.GetSeed()).Add(OnStateHashEvent());
+		return hasher.Get();
+	}
+} // namespace app
+
+/**
+ * @namespace app
+ * @brief Randomness
+ **/
+namespace app
+{
+	/// @brief Retrieves the seed of all gameplay random streams.
+	/// @return The current seed.
+	uint64_t GameEngine::GetRandomSeed() const
+	{
+		return random.GetSeed();
+	}
+
+	/// @brief Sets the seed of all gameplay random streams (e.g. from a save or a replay).
+	/// @param uSeed The seed to use.
+	void GameEngine::SetRandomSeed(const uint64_t uSeed)
+	{
+		random.SetSeed(uSeed);
+	}
+
+	/// @brief Retrieves a deterministic random stream derived from the current seed.
+	/// @param uDomain The gameplay domain of the stream.
+	/// @param uIndex The index inside the domain (e.g. map level).
+	/// @return The random stream.
+	RandomStream GameEngine::GetRandomStream(const uint64_t uDomain, const uint64_t uIndex) const
+	{
+		return random.GetStream(uDomain, uIndex);
+	}
 } // namespace app
 
 /**
@@ -397,37 +765,215 @@ namespace app
 	/// @return Always return true on default
 	bool GameEngine::OnFixedUpdateEvent(const engine::Tick& eTickMessage)
 	{
-		OnFixedUpdateEvent(frame.GetTickTime(), eTickMessage);
+		profiler.Mark(eTickMessage);
+		if (simulation.IsFixed()) {
+			OnFixedUpdateEvent(simulation.GetTime(), eTickMessage);
+		}
+		else {
+			OnFixedUpdateEvent(headless.IsVirtualTime() ? headless.GetTime() : frame.GetTickTime(), eTickMessage);
+		}
 		return true;
 	}
 
-	/// @brief Updates keyboard input and updates the keyboard state.
-	/// @return True if the input handling was successful.
+	/// @brief Applies the queued window events, the scripted input or the replay, then updates the keyboard state.
+	/// @return True if the input handling was successful, false at the end of a replay.
 	bool GameEngine::UpdateKeyboardInput()
 	{
+		if (replay.IsEnd(uInputSample)) { // No more input recorded
+			return false;
+		}
+		OnFixedUpdateEvent(engine::PRE_WINDOW_EVENT);
+		ApplyInputEvents();
+		OnFixedUpdateEvent(engine::POST_WINDOW_EVENT);
+		OnFixedUpdateEvent(engine::BEFORE_LOAD_KEYBOARD_EVENT);
+		if (headless.IsEnabled()) {
+			headless.ApplyInput(keyboard);
+		}
+		UpdateReplay();
 		keyboard.UpdateKeyboard();
+		uInputSample++;
 		return true;
 	}
 
+	/// @brief Applies the window events queued since the last keyboard sample (engine loop thread only).
+	/// @details A key changes at most once per sample, its next events wait for the next sample, so a
+	/// press and a release arriving between two samples are still seen as two edges.
+	/// @return The number of applied events.
+	size_t GameEngine::ApplyInputEvents()
+	{
+		const int64_t nNow = InputEvent::GetTimestamp();
+		std::bitset<KEYBOARD_SIZE> changedKeys;
+		size_t uApplied = 0;
+		if (replay.IsLoaded()) { // The replay is the only input
+			inputQueue.Clear();
+			return uApplied;
+		}
+		while (const InputEvent* pEvent = inputQueue.Front()) {
+			if (pEvent->eType == InputEvent::KEY_DOWN || pEvent->eType == InputEvent::KEY_UP) {
+				if (changedKeys[pEvent->eKey]) {
+					break; // Left for the next sample
+				}
+				changedKeys[pEvent->eKey] = true;
+				keyboard.SetKey(pEvent->eKey, pEvent->eType == InputEvent::KEY_DOWN);
+				pendingInput = LatencyTag{ pEvent->nTimestamp, nNow };
+			}
+			else {
+				keyboard.SetFocus(pEvent->eType == InputEvent::FOCUS_GAINED);
+			}
+			inputLatency.Add(static_cast<double>(nNow - pEvent->nTimestamp) * 1e-6);
+			inputQueue.Pop();
+			uApplied++;
+		}
+		inputLatency.uDropped += inputQueue.TakeDropped();
+		return uApplied;
+	}
+
+	/// @brief Sends an input event to the engine loop (window thread only) and wakes a paused engine.
+	/// @param eType The type of the event.
+	/// @param eKey The key of a key event.
+	/// @return True if the event was queued, false if the queue was full.
+	bool GameEngine::PushInputEvent(const InputEvent::Type eType, const Key eKey)
+	{
+		const bool bPushed = inputQueue.Push(InputEvent{ eType, eKey, InputEvent::GetTimestamp() });
+		inputEvent.Set();
+		return bPushed;
+	}
+
+	/// @brief Starts the requested recording and the loaded replay at keyboard sample 0 (after OnCreateEvent).
+	/// @return True if a recording or a replay started.
+	bool GameEngine::BeginReplay()
+	{
+		uInputSample = 0;
+		const float fTimeStep = simulation.IsFixed() ? simulation.GetTimeStep() : 0.0f;
+		if (replay.IsLoaded()) {
+			if (replay.GetHeader().fTimeStep != fTimeStep) {
+				std::cerr << "Warning: replay recorded with time step " << replay.GetHeader().fTimeStep
+					<< " s, played with " << fTimeStep << " s" << std::endl;
+			}
+			keyboard.SetFocus(true);
+			inputQueue.Clear();
+		}
+		if (recorder.IsRequested()) {
+			recorder.Begin(random.GetSeed(), nReplayLevel, fTimeStep);
+		}
+		return recorder.IsRecording() || replay.IsLoaded();
+	}
+
+	/// @brief Feeds the replay to the keyboard, records the key changes, and hashes the state at the
+	/// hash samples, before the keyboard sample uInputSample is taken.
+	/// @return True if the state matches the replay (always true without replay).
+	bool GameEngine::UpdateReplay()
+	{
+		if (replay.IsLoaded()) {
+			replay.Apply(uInputSample, keyboard);
+		}
+		if (recorder.IsRecording()) {
+			for (size_t uKey = 0; uKey < KEYBOARD_SIZE; uKey++) {
+				bool bPressed = false;
+				if (keyboard.GetKeyChange(static_cast<Key>(uKey), bPressed)) {
+					recorder.RecordKey(uInputSample, static_cast<Key>(uKey), bPressed);
+				}
+			}
+		}
+		if (!recorder.IsHashSample(uInputSample) && !replay.IsHashSample(uInputSample)) {
+			return true;
+		}
+		const uint64_t uStateHash = HashState();
+		if (recorder.IsHashSample(uInputSample)) {
+			recorder.RecordHash(uInputSample, uStateHash);
+		}
+		return replay.Verify(uInputSample, uStateHash);
+	}
+
+	/// @brief Ends the recording and the replay with the final state hash, and reports them.
+	/// @return True if the replay reached the end of the recording with the same states (always true without replay).
+	bool GameEngine::EndReplay()
+	{
+		if (!recorder.IsRecording() && !replay.IsLoaded()) {
+			return true;
+		}
+		const uint64_t uStateHash = HashState();
+		if (recorder.IsRecording() && recorder.End(uInputSample, uStateHash)) {
+			std::cout << recorder.GetSummary().Show() << std::endl;
+		}
+		if (!replay.IsLoaded()) {
+			return true;
+		}
+		const bool bIdentical = replay.Finish(uInputSample, uStateHash);
+		std::cout << replay.GetSummary().Show() << std::endl;
+		return bIdentical;
+	}
+
 	/// @brief Updates rendering of the game.
 	/// @param fElapsedTime - The elapsed time since the last frame.
 	/// @return True if rendering was successful.
-	bool GameEngine::RenderTexture() const
+	bool GameEngine::RenderTexture()
 	{
-		texture.RenderTexture(ScreenWidth(), ScreenHeight(), viewport);
+		TRACE_FUNCTION();
+		DrawOverlay();
+		if (reactionTag.IsValid()) {
+			reactionTag.nComposed = InputEvent::GetTimestamp();
+		}
+		if (bPublishFrames) { // Presented by the engine thread
+			PublishFrame();
+		}
+		else if (!headless.IsEnabled()) {
+			texture.RenderTexture(ScreenWidth(), ScreenHeight(), viewport);
+			presentLatency.Add(reactionTag, InputEvent::GetTimestamp());
+		}
+		reactionTag = LatencyTag();
+		overlay.Restore(texture.GetDrawTarget()); // The next frame is drawn without the overlay
 		return true;
 	}
 
-	bool GameEngine::UpdateWindowTitleSuffix(
-		const std::string& sTitleSuffix) const
+	/// @brief Draws the performance overlay on the frame about to be presented, then resets the draw counters.
+	/// @return True if the overlay was drawn.
+	bool GameEngine::DrawOverlay()
+	{
+		if (governor.IsShedding()) { // The overlay is optional work
+			texture.ResetDrawStats();
+			return false;
+		}
+		OverlayStats stats{};
+		if (overlay.IsVisible()) {
+			stats.uMemory = platform::GetProcessMemory();
+			stats.nFPS = frame.GetFPS();
+			stats.fFrameBudget = static_cast<float>(frame.GetDelay()) / 1000.0f;
+			stats.uDrawCalls = texture.GetDrawCalls();
+			stats.uDrawnPixels = texture.GetDrawnPixels();
+		}
+		const bool bDrawn = overlay.Draw(texture, profiler, stats);
+		texture.ResetDrawStats();
+		return bDrawn;
+	}
+
+	/// @brief Shows the FPS in the window title, at most once per TITLE_UPDATE_INTERVAL and only when it changes.
+	/// @return True if the window title was updated.
+	bool GameEngine::UpdateWindowTitleSuffix()
 	{
+		if (!windowHandler) {
+			return false;
+		}
+		const auto tNow = std::chrono::steady_clock::now();
+		if (tNow - tTitleUpdate < std::chrono::milliseconds(engine::TITLE_UPDATE_INTERVAL)) {
+			return false;
+		}
+		tTitleUpdate = tNow;
+		std::string sSuffix = frame.ShowFPS();
+		if (sSuffix == sTitleSuffix) {
+			return false;
+		}
+		sTitleSuffix = std::move(sSuffix);
+#ifdef _WIN32
 		const std::string sTitle = sAppName + sTitleSuffix;
 		SetWindowText(windowHandler, to_text(sTitle));
+#endif
 		return true;
 	}
 
 	bool GameEngine::CreateWindowIcon() const
 	{
+#ifdef _WIN32
 		auto hIcon = static_cast<HICON>(LoadImage(nullptr, to_text(engine::ICON_FILE_PATH), IMAGE_ICON, 0, 0, LR_LOADFROMFILE));
 		if (hIcon) {
 			std::cerr << "Successfully loaded engine icon (path = \""
@@ -460,6 +1006,9 @@ namespace app
 		}
 
 		return true;
+#else
+		return false;
+#endif
 	}
 
 	/// @brief Initializes the engine thread.
@@ -477,35 +1026,93 @@ namespace app
 	bool GameEngine::UpdateEngineEvent()
 	{
 		frame.ResetTimer();
+		simulation.Reset();
 
 		OnFixedUpdateEvent(engine::BEFORE_CREATE_EVENT);
 		bEngineRunning = OnCreateEvent(); // Start the event if the user creates it
 		OnFixedUpdateEvent(engine::AFTER_CREATE_EVENT);
+		BeginReplay();
+
+		if (bSimulationThread && !headless.IsEnabled()) {
+			RunSimulationThread();
+		}
+		else {
+			UpdateEngineLoop();
+		}
+		EndReplay();
+
+		std::cout << frame.GetJitter().Show() << std::endl;
+		frame.ResetJitter();
+		if (inputLatency.uEvents > 0) {
+			std::cout << inputLatency.Show() << std::endl;
+			inputLatency = InputLatency();
+		}
+		if (presentLatency.GetCount() > 0) {
+			std::cout << presentLatency.Show();
+			presentLatency.Reset();
+		}
+		if (profiler.IsEnabled() && profiler.GetFrameCount() > 0) {
+			std::cout << profiler.ShowStats();
+			DumpProfile();
+		}
+
+		OnFixedUpdateEvent(engine::BEFORE_DESTROY_EVENT);
+		const bool result =
+			!OnDestroyEvent(); // Continue the thread until it gets destroyed
+		OnFixedUpdateEvent(engine::AFTER_DESTROY_EVENT);
+
+		return result;
+	}
 
-		float fLastRunTime = 0;
+	/// @brief Runs the engine loop (input, update, render, pacing and pause) until the engine stops.
+	/// @return Always return true on default
+	bool GameEngine::UpdateEngineLoop()
+	{
 		while (bEngineRunning) {
+			TRACE_ZONE("Frame");
+			const auto tFrameStart = std::chrono::steady_clock::now();
 			OnFixedUpdateEvent(engine::PRE_RUNNING_EVENT);
 
-			/// Scope: Load data
-			{
-				UpdateKeyboardInput();
+			/// Scope: Load data (once per simulation step in fixed-rate mode)
+			if (!simulation.IsFixed()) {
+				if (!UpdateKeyboardInput()) { // End of the replay
+					bEngineRunning = false;
+					break;
+				}
 				OnFixedUpdateEvent(engine::AFTER_LOAD_KEYBOARD_EVENT);
 			}
 			// Scope: Update game
 			{
+				TRACE_ZONE("Update");
 				OnFixedUpdateEvent(engine::BEFORE_UPDATE_EVENT);
-				const float fElapsedTime = frame.GetElapsedTime(true);
-				if (!OnUpdateEvent(fElapsedTime)) { // Stop <=> no more updates
-					bEngineRunning = false;           // Do not return, using break instead
-					break;                            // so we can use OnDestroyEvent()
+				const float fElapsedTime = headless.IsVirtualTime() ? VirtualElapsedTime() : frame.GetElapsedTime(true);
+				const float fStepTime = simulation.IsFixed() ? simulation.GetTimeStep() : fElapsedTime;
+				const int nSteps = simulation.Accumulate(fElapsedTime);
+				for (int nStep = 0; nStep < nSteps; nStep++) {
+					if (simulation.IsFixed()) { // Key edges are kept until a step consumes them
+						if (!UpdateKeyboardInput()) { // End of the replay
+							bEngineRunning = false;
+							break;
+						}
+						OnFixedUpdateEvent(engine::AFTER_LOAD_KEYBOARD_EVENT);
+					}
+					if (!OnUpdateEvent(fStepTime)) { // Stop <=> no more updates
+						bEngineRunning = false;
+						break;
+					}
+					simulation.Step();
+				}
+				if (!bEngineRunning) { // Do not return, using break instead
+					break;             // so we can use OnDestroyEvent()
 				}
-				UpdateWindowTitleSuffix(frame.ShowFPS());
+				UpdateWindowTitleSuffix();
 				OnFixedUpdateEvent(engine::AFTER_UPDATE_TITLE_EVENT);
-				OnLateUpdateEvent(fElapsedTime, fElapsedTime + frame.GetElapsedTime(false));
+				OnLateUpdateEvent(fElapsedTime, fElapsedTime + (headless.IsVirtualTime() ? 0.0f : frame.GetElapsedTime(false)));
 				OnFixedUpdateEvent(engine::AFTER_UPDATE_EVENT);
 			}
-			// Scope: Rendering scence
-			{
+			// Scope: Rendering scence (headless runs may only render one frame out of a few)
+			if (!headless.IsEnabled() || headless.IsRenderFrame()) {
+				TRACE_ZONE("Render");
 				OnFixedUpdateEvent(engine::BEFORE_SCENE_RENDER_EVENT);
 				if (!OnRenderEvent()) {
 					bEngineRunning = false; // Do not return, using break instead
@@ -514,32 +1121,152 @@ namespace app
 				OnFixedUpdateEvent(engine::AFTER_SCENE_RENDER_EVENT);
 				RenderTexture();
 				OnFixedUpdateEvent(engine::AFTER_RENDER_EVENT);
+				if (headless.IsEnabled()) {
+					headless.CountRender();
+				}
 			}
 			// Scope: Post proccessing
 			{
+				if (!headless.IsEnabled()) {
+					UpdateFrameGovernor(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tFrameStart).count());
+				}
 				OnFixedUpdateEvent(engine::BEFORE_POST_PROCCESSING_EVENT);
-				frame.WaitMicroseconds(frame.GetDelay(), (frame.GetTickTime() - fLastRunTime) * 1000000);
-				fLastRunTime = frame.GetTickTime();
+				{
+					TRACE_ZONE("Wait");
+					if (!headless.IsVirtualTime()) {
+						frame.WaitNextFrame();
+					}
+				}
 				OnFixedUpdateEvent(engine::AFTER_POST_PROCCESSING_EVENT);
+				// Paused: present only when the pause screen changed, and sleep until the next input
 				const float fStartPauseTime = frame.GetTickTime();
-				while (!OnPauseEvent()) {
-					frame.WaitMicroseconds(frame.GetDelay());
-					RenderTexture();
-					UpdateKeyboardInput();
+				bool bPaused = false;
+				while (bEngineRunning && !OnPauseEvent()) {
+					TRACE_ZONE("Pause");
+					bPaused = true;
+					if (texture.GetDrawnPixels() > 0) {
+						RenderTexture();
+					}
+					if (headless.IsEnabled()) { // One scripted frame per pause iteration
+						headless.NextFrame(true);
+						bEngineRunning = !headless.IsFinished();
+					}
+					else {
+						inputEvent.Wait(engine::PAUSE_WAKE_INTERVAL);
+					}
+					if (!UpdateKeyboardInput()) { // End of the replay
+						bEngineRunning = false;
+					}
+				}
+				if (bPaused) {
+					frame.RestartPacing();
 				}
 				const float fEndPauseTime = frame.GetTickTime();
 				frame.Rewind(fEndPauseTime - fStartPauseTime);
 				OnFixedUpdateEvent(engine::ON_UNPAUSE_EVENT);
 			}
 			OnFixedUpdateEvent(engine::POST_RUNNING_EVENT);
+			if (headless.IsEnabled() && bEngineRunning) { // Not counted twice when a paused frame ends the run
+				headless.NextFrame();
+				bEngineRunning = !headless.IsFinished();
+			}
 		}
+		return true;
+	}
 
-		OnFixedUpdateEvent(engine::BEFORE_DESTROY_EVENT);
-		const bool result =
-			!OnDestroyEvent(); // Continue the thread until it gets destroyed
-		OnFixedUpdateEvent(engine::AFTER_DESTROY_EVENT);
+	/// @brief Advances the virtual clock of a headless run by one frame (the frame delay, unless the options set one).
+	/// @return The virtual elapsed time since the last frame (seconds).
+	float GameEngine::VirtualElapsedTime()
+	{
+		const std::chrono::microseconds frameDelay(static_cast<int64_t>(frame.GetDelay())); // FrameDelay is in microseconds
+		const float fElapsedTime = headless.Advance(std::chrono::duration<float>(frameDelay).count());
+		frame.FrameUpdate(fElapsedTime);
+		return fElapsedTime;
+	}
 
-		return result;
+	/// @brief Measures the work of a frame, and applies the decision of the frame governor if any.
+	/// @param fFrameCost The work of the frame, frame pacing excluded (milliseconds).
+	/// @return True if the frame delay or the work shedding changed.
+	bool GameEngine::UpdateFrameGovernor(const float fFrameCost)
+	{
+		GovernorDecision decision{};
+		if (!governor.AddFrame(fFrameCost, frame.GetDelay(), decision)) {
+			return false;
+		}
+		TRACE_ZONE("Governor");
+		frame.SetDelay(decision.eTo);
+		std::cerr << decision.Show() << std::endl;
+		return true;
+	}
+
+	/// @brief Runs the engine loop on a simulation thread while this thread presents its frames.
+	/// @details The simulation thread composes each frame in the write buffer of a triple buffer and
+	/// publishes it from RenderTexture(). This thread owns the OpenGL context and always presents the
+	/// newest complete frame, so texture upload and buffer swaps never delay input and game logic.
+	/// @return Always return true on default
+	bool GameEngine::RunSimulationThread()
+	{
+		const int32_t nPixels = ScreenWidth() * ScreenHeight();
+		Sprite* pCanvas = texture.GetDefaultDrawTarget();
+		frames.Reset();
+		for (int nIndex = 0; nIndex < 3; nIndex++) {
+			ComposedFrame& composed = frames.GetBuffer(nIndex);
+			if (!composed.pSprite) {
+				composed.pSprite = std::make_unique<Sprite>(ScreenWidth(), ScreenHeight());
+			}
+			composed.latency = LatencyTag();
+		}
+		std::copy_n(pCanvas->GetData(), nPixels, frames.GetWriteBuffer().pSprite->GetData()); // Keep what OnCreateEvent drew
+		texture.SetDrawTarget(frames.GetWriteBuffer().pSprite.get());
+
+		frameEvent.Reset();
+		bPublishFrames = true;
+		bSimulationRunning = true;
+		std::thread simulationThread([this]() {
+			TRACE_THREAD("Simulation");
+			UpdateEngineLoop();
+			bSimulationRunning = false;
+			frameEvent.Set();
+			});
+		PresentFrames();
+		simulationThread.join();
+		bPublishFrames = false;
+
+		std::copy_n(frames.GetWriteBuffer().pSprite->GetData(), nPixels, pCanvas->GetData()); // Back to the default canvas
+		texture.SetDrawTarget(nullptr);
+		return true;
+	}
+
+	/// @brief Publishes the composed frame to the presenting thread (simulation thread only).
+	/// @return Always return true on default
+	bool GameEngine::PublishFrame()
+	{
+		if (reactionTag.IsValid()) {
+			frames.GetWriteBuffer().latency = reactionTag;
+		}
+		const ComposedFrame& published = frames.Publish();
+		ComposedFrame& target = frames.GetWriteBuffer();
+		// Drawing is incremental (menus only redraw what changed), so continue from the published frame
+		std::copy_n(published.pSprite->GetData(), ScreenWidth() * ScreenHeight(), target.pSprite->GetData());
+		target.latency = published.latency; // If the published frame is skipped, the next one closes its latency
+		texture.SetDrawTarget(target.pSprite.get());
+		frameEvent.Set();
+		return true;
+	}
+
+	/// @brief Presents the newest published frame whenever one is published, until the simulation stops.
+	/// @return Always return true on default
+	bool GameEngine::PresentFrames()
+	{
+		while (bSimulationRunning) {
+			frameEvent.Wait(100);
+			if (frames.Acquire()) {
+				TRACE_ZONE("Present");
+				texture.RenderTexture(ScreenWidth(), ScreenHeight(), viewport, frames.GetReadBuffer().pSprite->GetData());
+				presentLatency.Add(frames.GetReadBuffer().latency, InputEvent::GetTimestamp());
+			}
+		}
+		return true;
 	}
 
 	/// @brief Exits the engine thread and cleans up resources.
@@ -547,7 +1274,9 @@ namespace app
 	bool GameEngine::ExitEngineThread() const
 	{
 		texture.ExitDevice();
+#ifdef _WIN32
 		PostMessage(windowHandler, WM_DESTROY, 0, 0);
+#endif
 		return true;
 	}
 
@@ -556,9 +1285,10 @@ namespace app
 	/// @return True if the thread execution was successful.
 	bool GameEngine::HandleEngineThread()
 	{
+		TRACE_THREAD("Engine");
 		InitEngineThread();
 		while ((bEngineRunning = UpdateEngineEvent()))
-			Sleep(270); /// basic minor delay that user cant differentiate
+			std::this_thread::sleep_for(std::chrono::milliseconds(270)); /// basic minor delay that user cant differentiate
 		ExitEngineThread();
 		return true;
 	}
@@ -567,11 +1297,13 @@ namespace app
 	/// @return True if message handling was successful.
 	bool GameEngine::HandleWindowMessage()
 	{
+#ifdef _WIN32
 		MSG msg;
 		while (GetMessage(&msg, nullptr, 0, 0) > 0) {
 			TranslateMessage(&msg);
 			DispatchMessage(&msg);
 		}
+#endif
 		return true;
 	}
 
@@ -579,7 +1311,9 @@ namespace app
 	/// @return True if thread startup and message handling were successful.
 	bool GameEngine::StartEngineThread()
 	{
+		inputEvent.Reset();
 		auto thread = std::thread(&GameEngine::HandleEngineThread, this);
+		TRACE_THREAD("Window");
 		HandleWindowMessage();
 		thread.join();
 		return true;
@@ -592,6 +1326,7 @@ namespace app
  **/
 namespace app
 {
+#ifdef _WIN32
 	std::string GameEngine::SelectFilePath(const char* filter, const char* initialDir, bool saveDialog) const
 	{
 		char previousDir[MAX_PATH];
@@ -721,11 +1456,10 @@ namespace app
 											 const UINT uMsg, const WPARAM wParam,
 											 const LPARAM lParam)
 	{
+		TRACE_ZONE("WindowEvent");
 		static GameEngine* sge;
 
 		/// Engine events
-		if (sge)
-			sge->OnFixedUpdateEvent(engine::PRE_WINDOW_EVENT);
 		switch (uMsg) {
 			case WM_CREATE:
 				sge = static_cast<GameEngine*>(
@@ -733,6 +1467,7 @@ namespace app
 				return 0;
 			case WM_CLOSE:
 				sge->bEngineRunning = false;
+				sge->inputEvent.Set();
 				return 0;
 			case WM_DESTROY:
 				sge->OnForceDestroyEvent();
@@ -740,30 +1475,62 @@ namespace app
 				return 0;
 		}
 
-		/// Load keyboard
+		/// Queue keyboard events, the engine loop applies them when it samples the keyboard
 		if (sge) {
-			sge->OnFixedUpdateEvent(engine::BEFORE_LOAD_KEYBOARD_EVENT);
 			switch (uMsg) {
 				case WM_SETFOCUS:
-					sge->keyboard.SetFocus(true);
+					sge->PushInputEvent(InputEvent::FOCUS_GAINED);
 					return 0;
 				case WM_KILLFOCUS:
-					sge->keyboard.SetFocus(false);
+					sge->PushInputEvent(InputEvent::FOCUS_LOST);
 					return 0;
 				case WM_KEYDOWN:
-					sge->keyboard.UpdateKey(wParam, true);
+					if (!(lParam & (1 << 30))) { // Auto-repeats of a held key are not edges
+						sge->PushInputEvent(InputEvent::KEY_DOWN, TranslateKeyCode(static_cast<uint16_t>(wParam)));
+					}
 					return 0;
 				case WM_KEYUP:
-					sge->keyboard.UpdateKey(wParam, false);
+					sge->PushInputEvent(InputEvent::KEY_UP, TranslateKeyCode(static_cast<uint16_t>(wParam)));
 					return 0;
+				// F10 and keys pressed with Alt come as system keys: they are queued the same way, and only
+				// F10 is kept from the default handling (it would enter the window menu loop, Alt+F4 still closes)
+				case WM_SYSKEYDOWN:
+					if (!(lParam & (1 << 30))) {
+						sge->PushInputEvent(InputEvent::KEY_DOWN, TranslateKeyCode(static_cast<uint16_t>(wParam)));
+					}
+					if (wParam == VK_F10) {
+						return 0;
+					}
+					break;
+				case WM_SYSKEYUP:
+					sge->PushInputEvent(InputEvent::KEY_UP, TranslateKeyCode(static_cast<uint16_t>(wParam)));
+					if (wParam == VK_F10) {
+						return 0;
+					}
+					break;
 			}
 		}
 
 		// Calling handling function on default
-		if (sge)
-			sge->OnFixedUpdateEvent(engine::POST_WINDOW_EVENT);
 		return DefWindowProc(windowHandler, uMsg, wParam, lParam);
 	}
+#else
+	/// @brief No file dialog outside Windows
+	/// @return Always an empty path (as if the user canceled)
+	std::string GameEngine::SelectFilePath(const char* filter, const char* initialDir, bool saveDialog) const
+	{
+		std::cerr << "No file dialog on this platform." << std::endl;
+		return "";
+	}
+
+	/// @brief No window outside Windows: the engine only runs headless (StartHeadless)
+	/// @return Always nullptr
+	WindowHandle GameEngine::WindowCreate()
+	{
+		std::cerr << "Error: The game window needs Windows, run the game with --headless on this platform." << std::endl;
+		return nullptr;
+	}
+#endif
 
 	std::atomic<bool> GameEngine::bEngineRunning{ false };
 } // namespace app
@@ -2,17 +2,31 @@
 #define G_GAME_ENGINE_CORE_H
 #pragma once
 
+#ifdef _WIN32
 #pragma comment(lib, "user32.lib")
+#endif
+#include <chrono>
+#include <memory>
 #include <thread>
-#include <windows.h>
 
 #include "gConst.h"
+#include "gGovernor.h"
+#include "gHeadless.h"
+#include "gInputQueue.h"
 #include "gKey.h"
+#include "gLatency.h"
+#include "gOverlay.h"
 #include "gPixel.h"
+#include "gPlatform.h"
+#include "gProfiler.h"
+#include "gRandom.h"
+#include "gReplay.h"
 #include "gResourcePack.h"
 #include "gSprite.h"
 #include "gState.h"
 #include "gTexture.h"
+#include "gTrace.h"
+#include "gTripleBuffer.h"
 
 #ifndef G_GAME_ENGINE_DEF
 #define G_GAME_ENGINE_DEF
@@ -36,6 +50,7 @@ namespace app
 		engine::Code Construct(uint32_t screen_w, uint32_t screen_h, uint32_t pixel_w,
 			uint32_t pixel_h, bool full_screen = false);
 		engine::Code Start();
+		engine::Code StartHeadless(HeadlessOptions options);
 
 	public: // Override Interfaces
 		virtual bool OnCreateEvent();
@@ -47,6 +62,7 @@ namespace app
 		virtual bool OnPauseEvent();
 		virtual bool OnDestroyEvent();
 		virtual bool OnForceDestroyEvent();
+		virtual uint64_t OnStateHashEvent();
 
 	public: // Hardware Interfaces
 		bool IsFocused() const;
@@ -79,29 +95,127 @@ namespace app
 		void DrawSprite(int32_t nOffsetX, int32_t nOffsetY, const Sprite* pSprite, uint32_t uScale = 1);
 		void DrawPartialSprite(int32_t nOffsetX, int32_t nOffsetY, const Sprite* pSprite, int32_t nOriginX, int32_t nOriginY, int32_t nWidth, int32_t nHeight, uint32_t uScale = 1);
 		void Clear(Pixel p = app::BLACK) const;
+		bool CaptureFrame(Sprite* pFrame) const;
 
 	public: // Engine Customization
 		FrameDelay GetFrameDelay() const;
 		int GetAppFPS() const;
 		bool SetFrameDelay(FrameDelay eFrameDelay);
-		bool RenderTexture() const;
+		bool SetFixedTimeStep(float fTimeStep);
+		float GetFixedTimeStep() const;
+		float GetRenderAlpha() const;
+		bool SetSimulationThread(bool bEnable);
+		bool IsSimulationThread() const;
+		FrameJitter GetFrameJitter() const;
+		void SetFrameGovernor(bool bEnable, FrameDelay eFastest = HIGH_FPS_DELAY, FrameDelay eSlowest = SLOW_FPS_DELAY);
+		bool IsFrameGovernor() const;
+		bool IsSheddingWork() const;
+		InputLatency GetInputLatency() const;
+		void MarkInputReaction();
+		PresentLatency GetPresentLatency() const;
+		bool RenderTexture();
 		std::string SelectFilePath(const char* filter, const char* initialDir, bool saveDialog = false) const;
 
+	public: // Profiling
+		void SetProfiling(bool bEnable);
+		FrameProfiler::PhaseStats GetProfileStats(FrameProfiler::Phase ePhase) const;
+		FrameProfiler::FrameTimes GetProfileFrame(size_t uAge = 0) const;
+		bool DumpProfile() const;
+		void SetOverlay(bool bShow);
+		bool ToggleOverlay();
+		bool IsOverlay() const;
+		void SetTracing(bool bEnable);
+		bool IsTracing() const;
+		bool DumpTrace() const;
+
+	public: // Headless
+		bool IsHeadless() const;
+		uint64_t GetHeadlessFrame() const;
+		HeadlessSummary GetHeadlessSummary() const;
+		uint64_t HashFrame() const;
+
+	public: // Replay
+		bool RecordReplay(const std::string& sFilePath, uint32_t uHashInterval = engine::REPLAY_HASH_INTERVAL);
+		bool LoadReplay(const std::string& sFilePath);
+		bool IsRecording() const;
+		bool IsReplaying() const;
+		int32_t GetReplayLevel() const;
+		void SetReplayLevel(int32_t nLevel);
+		ReplaySummary GetReplaySummary() const;
+		uint64_t HashState();
+
+	public: // Randomness
+		uint64_t GetRandomSeed() const;
+		void SetRandomSeed(uint64_t uSeed);
+		RandomStream GetRandomStream(uint64_t uDomain, uint64_t uIndex = 0) const;
+
 	private: // Engine Internalities
 		ScreenState screen;
 		ViewportState viewport;
 		KeyboardState keyboard;
 		Texture texture;
 		FrameState frame;
+		SimulationState simulation;
+		Random random;
+		FrameProfiler profiler;
+		PerformanceOverlay overlay;
+		HeadlessState headless;
+		FrameGovernor governor;
 		// MouseState mouse; [unused]
 
+		// Simulation thread mode: frames composed by the simulation thread, presented by the engine thread
+		struct ComposedFrame
+		{
+			std::unique_ptr<Sprite> pSprite; ///< Pixels of the frame
+			LatencyTag latency;              ///< Input event the frame is the first to react to (carried until presented)
+		};
+		TripleBuffer<ComposedFrame> frames;
+		WakeEvent frameEvent;
+		bool bSimulationThread = false;
+		bool bPublishFrames = false;
+		std::atomic<bool> bSimulationRunning{ false };
+
+		// Input events of the window thread, applied by the engine loop when it samples the keyboard
+		InputQueue<InputEvent, engine::INPUT_QUEUE_SIZE> inputQueue;
+		InputLatency inputLatency;
+
+		// Input-to-present latency: the newest applied input event, then the reaction of the current frame
+		LatencyTag pendingInput;
+		LatencyTag reactionTag;
+		PresentLatency presentLatency;
+
+		// Input replay, at keyboard sample granularity (one sample per UpdateKeyboardInput)
+		ReplayRecorder recorder;
+		ReplayPlayer replay;
+		uint64_t uInputSample = 0;
+		int32_t nReplayLevel = 0;
+
+		// Signaled by the window thread on input, so that a paused engine can block until then
+		WakeEvent inputEvent;
+
+		// Window title, only updated a few times per second and when it changes
+		std::string sTitleSuffix;
+		std::chrono::steady_clock::time_point tTitleUpdate;
+
 		bool OnFixedUpdateEvent(const engine::Tick& eTickMessage);
 		bool UpdateKeyboardInput();
-		bool UpdateWindowTitleSuffix(const std::string& sTitleSuffix) const;
+		size_t ApplyInputEvents();
+		bool PushInputEvent(InputEvent::Type eType, Key eKey = NONE);
+		bool BeginReplay();
+		bool UpdateReplay();
+		bool EndReplay();
+		bool UpdateWindowTitleSuffix();
 		bool CreateWindowIcon() const;
 		bool InitEngineThread();
 		bool ExitEngineThread() const;
 		bool UpdateEngineEvent();
+		bool UpdateEngineLoop();
+		float VirtualElapsedTime();
+		bool UpdateFrameGovernor(float fFrameCost);
+		bool RunSimulationThread();
+		bool PublishFrame();
+		bool PresentFrames();
+		bool DrawOverlay();
 		bool HandleEngineThread();
 		bool HandleWindowMessage();
 		bool StartEngineThread();
@@ -110,14 +224,16 @@ namespace app
 		// gracefully
 		static std::atomic<bool> bEngineRunning;
 
-		// Windows specific window handling
-		HWND windowHandler = nullptr;
-		HWND WindowCreate();
+		// Windows specific window handling (no window on other platforms)
+		WindowHandle windowHandler = nullptr;
+		WindowHandle WindowCreate();
+#ifdef _WIN32
 		void RegisterWindowClass(WNDCLASS& wc);
 
 		void CreateMainWindow();
 		static LRESULT CALLBACK WindowEvent(HWND windowHandler, UINT uMsg,
 			WPARAM wParam, LPARAM lParam);
+#endif
 	};
 } // namespace app
 #endif // G_GAME_ENGINE_DEF
@@ -0,0 +1,164 @@
+#include "gGovernor.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @file gGovernor.cpp
+ *
+ * @brief Contains frame governor decision struct and frame governor class implementation
+ *
+ * This file implements the frame governor. The cost of a window is its 90th percentile frame work, so
+ * a few slow frames (e.g. a level load) are enough to slow down but a single one is not.
+**/
+
+namespace app
+{
+	/// @brief Frame delays the governor moves along, from the fastest to the slowest
+	static constexpr FrameDelay LADDER[] = {
+		BEST_FPS_DELAY, HIGH_FPS_DELAY, SMOOTH_FPS_DELAY, STABLE_FPS_DELAY,
+		MEDIUM_FPS_DELAY, SAFE_FPS_DELAY, GOOD_FPS_DELAY, SLOW_FPS_DELAY,
+	};
+	static constexpr int LADDER_SIZE = static_cast<int>(sizeof(LADDER) / sizeof(LADDER[0]));
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////// GOVERNOR DECISION ///////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for the decision as a string
+	std::string GovernorDecision::Show() const
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(2);
+		output << "[Governor: work p90 " << fCost << " ms of " << fBudget << " ms budget";
+		if (eFrom != eTo) {
+			output << ", frame delay " << static_cast<int>(eFrom) << " -> " << static_cast<int>(eTo) << " us";
+		}
+		output << (bShedding ? ", shedding optional work" : ", full work") << "]";
+		return output.str();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// FRAME GOVERNOR ////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, the governor is disabled
+	FrameGovernor::FrameGovernor()
+	{
+		eFastest = HIGH_FPS_DELAY;
+		eSlowest = SLOW_FPS_DELAY;
+		bEnabled = false;
+		Reset();
+	}
+
+	/// @brief Enable or disable the governor
+	/// @param bEnable true to let the governor change the frame delay
+	/// @param eFastestDelay Shortest frame delay the governor may pick
+	/// @param eSlowestDelay Longest frame delay the governor may pick (optional work is shed beyond it)
+	void FrameGovernor::SetEnabled(const bool bEnable, const FrameDelay eFastestDelay, const FrameDelay eSlowestDelay)
+	{
+		bEnabled = bEnable;
+		eFastest = std::min(eFastestDelay, eSlowestDelay);
+		eSlowest = std::max(eFastestDelay, eSlowestDelay);
+		Reset();
+	}
+
+	/// @brief Drop the measured frames and stop shedding work
+	void FrameGovernor::Reset()
+	{
+		arrCosts.fill(0.0f);
+		uCostCount = 0;
+		nRaiseWindows = 0;
+		bShedding = false;
+		uDecisions = 0;
+	}
+
+	/// @brief Check if the governor changes the frame delay
+	bool FrameGovernor::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/// @brief Check if the frames overrun the slowest allowed budget (optional work should be shed)
+	bool FrameGovernor::IsShedding() const
+	{
+		return bEnabled && bShedding;
+	}
+
+	/// @brief Getter for the number of decisions since enabled
+	size_t FrameGovernor::GetDecisionCount() const
+	{
+		return uDecisions;
+	}
+
+	/// @brief Measure a frame, and decide at the end of each window
+	/// @param fCost Work of the frame, without the frame pacing wait (milliseconds)
+	/// @param eCurrent Current frame delay
+	/// @param decision Receives the decision, if any
+	/// @return true if the frame delay or the work shedding changed, false otherwise
+	bool FrameGovernor::AddFrame(const float fCost, const FrameDelay eCurrent, GovernorDecision& decision)
+	{
+		if (!bEnabled) {
+			return false;
+		}
+		arrCosts[uCostCount++] = fCost;
+		if (uCostCount < WINDOW_FRAMES) {
+			return false;
+		}
+		uCostCount = 0;
+		auto itP90 = arrCosts.begin() + (WINDOW_FRAMES * 9) / 10;
+		std::nth_element(arrCosts.begin(), itP90, arrCosts.end());
+		const float fP90 = *itP90;
+
+		const int nFastest = GetRung(eFastest);
+		const int nSlowest = GetRung(eSlowest);
+		const int nCurrent = std::clamp(GetRung(eCurrent), nFastest, nSlowest);
+		int nNext = nCurrent;
+		bool bShed = bShedding;
+		if (fP90 > LOWER_THRESHOLD * GetBudget(nCurrent)) { // Over budget: slow down at once, as far as needed
+			nRaiseWindows = 0;
+			while (nNext < nSlowest && fP90 > LOWER_THRESHOLD * GetBudget(nNext)) {
+				nNext++;
+			}
+			bShed = bShedding || fP90 > LOWER_THRESHOLD * GetBudget(nNext);
+		}
+		else if (bShedding) { // Restore the optional work before speeding up
+			nRaiseWindows = 0;
+			bShed = fP90 >= RAISE_THRESHOLD * GetBudget(nCurrent);
+		}
+		else if (nCurrent > nFastest && fP90 < RAISE_THRESHOLD * GetBudget(nCurrent - 1)) {
+			if (++nRaiseWindows >= RAISE_WINDOWS) {
+				nRaiseWindows = 0;
+				nNext = nCurrent - 1;
+			}
+		}
+		else {
+			nRaiseWindows = 0;
+		}
+
+		if (LADDER[nNext] == eCurrent && bShed == bShedding) {
+			return false;
+		}
+		decision = GovernorDecision{ eCurrent, LADDER[nNext], bShed, fP90, static_cast<float>(eCurrent) / 1000.0f };
+		bShedding = bShed;
+		uDecisions++;
+		return true;
+	}
+
+	/// @brief Getter for the ladder rung of a frame delay (the fastest rung not faster than the delay)
+	int FrameGovernor::GetRung(const FrameDelay eDelay)
+	{
+		for (int nRung = 0; nRung < LADDER_SIZE; nRung++) {
+			if (LADDER[nRung] >= eDelay) {
+				return nRung;
+			}
+		}
+		return LADDER_SIZE - 1;
+	}
+
+	/// @brief Getter for the frame budget of a ladder rung (milliseconds)
+	float FrameGovernor::GetBudget(const int nRung)
+	{
+		return static_cast<float>(LADDER[nRung]) / 1000.0f;
+	}
+} // namespace app
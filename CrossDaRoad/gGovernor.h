@@ -0,0 +1,76 @@
+#ifndef G_GOVERNOR_H
+#define G_GOVERNOR_H
+
+#include "gState.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file gGovernor.h
+ *
+ * @brief Contains frame governor decision struct and frame governor class
+ *
+ * This file contains the frame budget governor of the engine loop. It measures the work of each frame
+ * (everything but the frame pacing wait), and once per window of frames it moves the frame delay
+ * along the FrameDelay ladder: down at once when the frames overrun their budget, up only after a few
+ * windows with a wide margin under the faster budget, so the cap never oscillates. Below the slowest
+ * allowed delay, it asks the game to shed optional work instead.
+**/
+
+namespace app
+{
+	/// @brief Change of frame delay or work shedding decided by the governor
+	struct GovernorDecision
+	{
+		FrameDelay eFrom;  ///< Frame delay before the decision
+		FrameDelay eTo;    ///< Frame delay after the decision
+		bool bShedding;    ///< If optional work is shed after the decision
+		float fCost;       ///< 90th percentile of the frame work over the window (milliseconds)
+		float fBudget;     ///< Frame budget before the decision (milliseconds)
+
+		std::string Show() const;
+	};
+
+	/// @brief Adaptive frame delay, picked on the FrameDelay ladder from the measured frame work
+	class FrameGovernor
+	{
+	public:
+		static constexpr size_t WINDOW_FRAMES = 64;    ///< Frames measured between two decisions
+		static constexpr float LOWER_THRESHOLD = 0.9f; ///< Slow down when the work exceeds this part of the budget
+		static constexpr float RAISE_THRESHOLD = 0.6f; ///< Speed up when the work fits in this part of the faster budget
+		static constexpr int RAISE_WINDOWS = 3;        ///< Consecutive windows under the raise threshold before speeding up
+
+	private:
+		std::array<float, WINDOW_FRAMES> arrCosts; ///< Frame work of the current window (milliseconds)
+		size_t uCostCount;    ///< Number of measured frames in the current window
+		int nRaiseWindows;    ///< Consecutive windows under the raise threshold
+		FrameDelay eFastest;  ///< Shortest allowed frame delay
+		FrameDelay eSlowest;  ///< Longest allowed frame delay
+		bool bEnabled;        ///< If the governor changes the frame delay
+		bool bShedding;       ///< If optional work should be shed
+		size_t uDecisions;    ///< Number of decisions since enabled
+
+	public: // Constructors & Destructor
+		FrameGovernor();
+		~FrameGovernor() = default;
+
+	public: // Setters
+		void SetEnabled(bool bEnable, FrameDelay eFastestDelay, FrameDelay eSlowestDelay);
+		void Reset();
+
+	public: // Getters
+		bool IsEnabled() const;
+		bool IsShedding() const;
+		size_t GetDecisionCount() const;
+
+	public: // Update
+		bool AddFrame(float fCost, FrameDelay eCurrent, GovernorDecision& decision);
+
+	private:
+		static int GetRung(FrameDelay eDelay);
+		static float GetBudget(int nRung);
+	};
+} // namespace app
+
+#endif // G_GOVERNOR_H
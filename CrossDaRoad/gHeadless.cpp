@@ -0,0 +1,164 @@
+#include "gHeadless.h"
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @file gHeadless.cpp
+ *
+ * @brief Contains headless summary struct and headless state class implementation
+ *
+ * This file implements the headless state. A frame is one iteration of the engine loop, or one
+ * iteration of its pause loop, so a script can pause and resume the game as a player would.
+**/
+
+namespace app
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////// HEADLESS SUMMARY ///////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for the summary as a string
+	std::string HeadlessSummary::Show() const
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(3);
+		output << "[Headless: " << uFrames << " frames (" << uPausedFrames << " paused, " << uRenderedFrames << " rendered), ";
+		output << uInputEvents << " input events, " << fVirtualTime << " s game time in " << fWallTime << " s";
+		if (fWallTime > 0) {
+			output << std::setprecision(1) << ", " << static_cast<double>(uFrames) / fWallTime << " simulated frames/s";
+			output << ", " << fVirtualTime / fWallTime << "x real time";
+		}
+		output << ", seed " << uSeed << ", frame hash " << std::hex << std::setw(16) << std::setfill('0') << uFrameHash << "]";
+		return output.str();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// HEADLESS STATE ////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, the engine is not headless
+	HeadlessState::HeadlessState()
+	{
+		bEnabled = false;
+		bFinished = false;
+		uFrame = 0;
+		uPausedFrames = 0;
+		uRenderedFrames = 0;
+		uInputEvents = 0;
+		fVirtualTime = 0;
+		fWallTime = 0;
+	}
+
+	/// @brief Start a headless run
+	/// @param headlessOptions Options of the run (the input script is rewound)
+	void HeadlessState::Start(HeadlessOptions headlessOptions)
+	{
+		options = std::move(headlessOptions);
+		options.script.Rewind();
+		bEnabled = true;
+		bFinished = false;
+		uFrame = 0;
+		uPausedFrames = 0;
+		uRenderedFrames = 0;
+		uInputEvents = 0;
+		fVirtualTime = 0;
+		tStart = std::chrono::steady_clock::now();
+		fWallTime = 0;
+	}
+
+	/// @brief Stop the headless run, the summary is kept
+	void HeadlessState::Stop()
+	{
+		if (bEnabled) {
+			fWallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+		}
+		bEnabled = false;
+	}
+
+	/// @brief Check if the engine runs headless
+	bool HeadlessState::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/// @brief Check if the engine runs headless on the virtual clock
+	bool HeadlessState::IsVirtualTime() const
+	{
+		return bEnabled && options.bVirtualTime;
+	}
+
+	/// @brief Check if the current frame is rendered (one frame out of the render interval)
+	bool HeadlessState::IsRenderFrame() const
+	{
+		return options.uRenderInterval > 0 && uFrame % options.uRenderInterval == 0;
+	}
+
+	/// @brief Getter for the options of the current or last run
+	const HeadlessOptions& HeadlessState::GetOptions() const
+	{
+		return options;
+	}
+
+	/// @brief Check if the frame limit or the stop condition was reached
+	bool HeadlessState::IsFinished() const
+	{
+		return bFinished;
+	}
+
+	/// @brief Getter for the current frame
+	uint64_t HeadlessState::GetFrame() const
+	{
+		return uFrame;
+	}
+
+	/// @brief Getter for the virtual clock (seconds)
+	float HeadlessState::GetTime() const
+	{
+		return static_cast<float>(fVirtualTime);
+	}
+
+	/// @brief Getter for the summary of the current or last run
+	HeadlessSummary HeadlessState::GetSummary() const
+	{
+		HeadlessSummary summary{};
+		summary.uFrames = uFrame;
+		summary.uPausedFrames = uPausedFrames;
+		summary.uRenderedFrames = uRenderedFrames;
+		summary.uInputEvents = uInputEvents;
+		summary.fVirtualTime = fVirtualTime;
+		summary.fWallTime = bEnabled ? std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count() : fWallTime;
+		return summary;
+	}
+
+	/// @brief Advance the virtual clock by one frame
+	/// @param fDefaultFrameTime Frame duration used when the options do not set one (seconds)
+	/// @return The virtual elapsed time of the frame (seconds)
+	float HeadlessState::Advance(const float fDefaultFrameTime)
+	{
+		const float fFrameTime = options.fFrameTime > 0 ? options.fFrameTime : fDefaultFrameTime;
+		fVirtualTime += fFrameTime;
+		return fFrameTime;
+	}
+
+	/// @brief Count a rendered frame
+	void HeadlessState::CountRender()
+	{
+		uRenderedFrames++;
+	}
+
+	/// @brief Feed the scripted events of the current frame to the keyboard, before a keyboard sample
+	/// @param keyboard Keyboard state receiving the events
+	void HeadlessState::ApplyInput(KeyboardState& keyboard)
+	{
+		uInputEvents += options.script.Apply(uFrame, keyboard);
+	}
+
+	/// @brief End the current frame and check the frame limit and the stop condition
+	/// @param bPaused true if the frame was spent in the pause loop
+	void HeadlessState::NextFrame(const bool bPaused)
+	{
+		uFrame++;
+		uPausedFrames += bPaused ? 1 : 0;
+		bFinished = (options.uFrames > 0 && uFrame >= options.uFrames) || (options.fnStop && options.fnStop());
+	}
+} // namespace app
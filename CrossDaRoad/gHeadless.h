@@ -0,0 +1,94 @@
+#ifndef G_HEADLESS_H
+#define G_HEADLESS_H
+
+#include "gInputScript.h"
+#include "gState.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @file gHeadless.h
+ *
+ * @brief Contains headless options struct, headless summary struct and headless state class
+ *
+ * This file contains the headless mode of the engine: the game loop runs without window, texture
+ * upload or frame pacing, the keyboard is fed by an input script and the frames advance a virtual
+ * clock, so a whole game session is reproducible and runs as fast as the game logic allows. With a
+ * fixed seed and the profiler enabled, it is the throughput benchmark of the engine.
+**/
+
+namespace app
+{
+	/// @brief Options of a headless run
+	struct HeadlessOptions
+	{
+		uint64_t uFrames = 600;       ///< Number of frames to run (0: until the stop condition or the game stops)
+		bool bVirtualTime = true;     ///< If frames advance a virtual clock (no pacing), otherwise the wall clock is used
+		float fFrameTime = 0.0f;      ///< Virtual duration of a frame in seconds (0: the frame delay of the game)
+		uint32_t uRenderInterval = 1; ///< Render one frame out of this number (0: never render)
+		bool bFixedSeed = false;      ///< If the gameplay random streams are seeded with uSeed
+		uint64_t uSeed = 0;           ///< Seed of the gameplay random streams (if bFixedSeed)
+		bool bProfile = false;        ///< If the phases of all frames are profiled and reported
+		InputScript script;           ///< Scripted keyboard input (frames count from 0)
+		std::function<bool()> fnStop; ///< Optional stop condition, checked after each frame
+	};
+
+	/// @brief Summary of a headless run
+	struct HeadlessSummary
+	{
+		uint64_t uFrames;         ///< Number of frames run (paused frames included)
+		uint64_t uPausedFrames;   ///< Number of frames spent in the pause loop
+		uint64_t uRenderedFrames; ///< Number of rendered frames
+		size_t uInputEvents;      ///< Number of applied scripted events
+		double fVirtualTime;      ///< Game time elapsed (seconds)
+		double fWallTime;         ///< Real time elapsed (seconds)
+		uint64_t uSeed;           ///< Seed of the gameplay random streams
+		uint64_t uFrameHash;      ///< Hash of the draw target (same seed, script and options give the same hash)
+
+		std::string Show() const;
+	};
+
+	/// @brief State of the headless mode: frame counter, virtual clock and scripted input
+	class HeadlessState
+	{
+	private:
+		bool bEnabled;               ///< If the engine runs headless
+		bool bFinished;              ///< If the frame limit or the stop condition was reached
+		HeadlessOptions options;     ///< Options of the current run
+		uint64_t uFrame;             ///< Current frame
+		uint64_t uPausedFrames;      ///< Number of paused frames
+		uint64_t uRenderedFrames;    ///< Number of rendered frames
+		size_t uInputEvents;         ///< Number of applied scripted events
+		double fVirtualTime;         ///< Virtual clock (seconds)
+		std::chrono::steady_clock::time_point tStart; ///< Wall clock at the start of the run
+		double fWallTime;            ///< Wall time of the run, set when it stops (seconds)
+
+	public: // Constructors & Destructor
+		HeadlessState();
+		~HeadlessState() = default;
+
+	public: // Setters
+		void Start(HeadlessOptions headlessOptions);
+		void Stop();
+
+	public: // Getters
+		bool IsEnabled() const;
+		bool IsVirtualTime() const;
+		bool IsRenderFrame() const;
+		const HeadlessOptions& GetOptions() const;
+		bool IsFinished() const;
+		uint64_t GetFrame() const;
+		float GetTime() const;
+		HeadlessSummary GetSummary() const;
+
+	public: // Update methods
+		float Advance(float fDefaultFrameTime);
+		void CountRender();
+		void ApplyInput(KeyboardState& keyboard);
+		void NextFrame(bool bPaused = false);
+	};
+} // namespace app
+
+#endif // G_HEADLESS_H
@@ -0,0 +1,150 @@
+#ifndef G_INPUT_QUEUE_H
+#define G_INPUT_QUEUE_H
+
+#include "gKey.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/**
+ * @file gInputQueue.h
+ *
+ * @brief Contains input event struct, input latency struct and lock-free event queue class template
+ *
+ * This file contains the input path between the window thread and the engine thread: the window
+ * thread pushes timestamped input events in a single-producer single-consumer ring, and the engine
+ * thread applies them to the keyboard state when it samples the keyboard. The keyboard state is
+ * only ever touched by the engine thread, and each event tells how long it waited in the queue.
+**/
+
+namespace app
+{
+	/// @brief Input event sent by the window thread
+	struct InputEvent
+	{
+		/// @brief Type of an input event
+		enum Type : uint8_t
+		{
+			KEY_DOWN,     ///< A key was pressed (auto-repeats are not sent)
+			KEY_UP,       ///< A key was released
+			FOCUS_GAINED, ///< The window gained the input focus
+			FOCUS_LOST,   ///< The window lost the input focus
+		};
+
+		Type eType;         ///< Type of the event
+		Key eKey;           ///< Key of a key event (NONE otherwise)
+		int64_t nTimestamp; ///< Time the window thread received the event (see GetTimestamp)
+
+		/// @brief Current time of the monotonic clock in nanoseconds
+		static int64_t GetTimestamp()
+		{
+			const auto now = std::chrono::steady_clock::now().time_since_epoch();
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+		}
+	};
+
+	/// @brief Time the input events waited between the window thread and the engine thread
+	struct InputLatency
+	{
+		size_t uEvents = 0;      ///< Number of applied events
+		size_t uDropped = 0;     ///< Number of events dropped because the queue was full
+		double fTotal = 0.0;     ///< Sum of the waiting times (milliseconds)
+		double fMax = 0.0;       ///< Longest waiting time (milliseconds)
+
+		/// @brief Add the waiting time of an applied event
+		/// @param fLatency Waiting time in milliseconds
+		void Add(const double fLatency)
+		{
+			uEvents++;
+			fTotal += fLatency;
+			fMax = std::max(fMax, fLatency);
+		}
+		/// @brief Getter for the mean waiting time (milliseconds)
+		double GetMean() const
+		{
+			return uEvents > 0 ? fTotal / static_cast<double>(uEvents) : 0.0;
+		}
+		/// @brief Getter for the statistics as a string
+		std::string Show() const
+		{
+			std::ostringstream output;
+			output << std::fixed << std::setprecision(3);
+			output << "[Input: " << uEvents << " events, queued " << GetMean() << " ms mean, " << fMax << " ms max";
+			if (uDropped > 0) {
+				output << ", " << uDropped << " dropped";
+			}
+			output << "]";
+			return output.str();
+		}
+	};
+
+	/// @brief Lock-free single-producer single-consumer queue of fixed capacity
+	/// @tparam T Element type (copied in and out of the ring)
+	/// @tparam N Capacity (a power of two)
+	template <class T, size_t N>
+	class InputQueue
+	{
+		static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity of the input queue must be a power of two");
+
+	private:
+		std::array<T, N> arrEvents;             ///< Ring of events
+		alignas(64) std::atomic<size_t> uHead;  ///< Next event to pop (written by the consumer)
+		alignas(64) std::atomic<size_t> uTail;  ///< Next free slot (written by the producer)
+		std::atomic<size_t> uDropped;           ///< Number of events dropped because the ring was full
+
+	public: // Constructors & Destructor
+		InputQueue() : arrEvents{}, uHead(0), uTail(0), uDropped(0) {}
+		~InputQueue() = default;
+		InputQueue(const InputQueue&) = delete;
+		InputQueue& operator=(const InputQueue&) = delete;
+
+	public: // Producer
+		/// @brief Push an event, dropped if the queue is full
+		/// @return true if the event was pushed, false if it was dropped
+		bool Push(const T& event)
+		{
+			const size_t uCurrentTail = uTail.load(std::memory_order_relaxed);
+			if (uCurrentTail - uHead.load(std::memory_order_acquire) >= N) {
+				uDropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			arrEvents[uCurrentTail & (N - 1)] = event;
+			uTail.store(uCurrentTail + 1, std::memory_order_release);
+			return true;
+		}
+
+	public: // Consumer
+		/// @brief Getter for the oldest event, without removing it
+		/// @return The event, nullptr if the queue is empty
+		const T* Front() const
+		{
+			const size_t uCurrentHead = uHead.load(std::memory_order_relaxed);
+			if (uCurrentHead == uTail.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+			return &arrEvents[uCurrentHead & (N - 1)];
+		}
+		/// @brief Remove the oldest event (the queue must not be empty, see Front)
+		void Pop()
+		{
+			uHead.store(uHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+		/// @brief Remove all events
+		void Clear()
+		{
+			uHead.store(uTail.load(std::memory_order_acquire), std::memory_order_release);
+		}
+		/// @brief Getter for the number of dropped events since the last call
+		size_t TakeDropped()
+		{
+			return uDropped.exchange(0, std::memory_order_relaxed);
+		}
+	};
+} // namespace app
+
+#endif // G_INPUT_QUEUE_H
@@ -0,0 +1,210 @@
+#include "gInputScript.h"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @file gInputScript.cpp
+ *
+ * @brief Contains input script class implementation
+ *
+ * This file implements the input script. Events are applied lazily: a key changes at most once per
+ * keyboard sample, so a press and a release falling into the same sample (e.g. a frame without any
+ * simulation step) are seen as two separate edges instead of cancelling each other.
+**/
+
+namespace app
+{
+	/// @brief Names of the keys which are not letters, digits or function keys
+	struct KeyName
+	{
+		const char* sName; ///< Name in the script (upper case)
+		Key eKey;          ///< Key
+	};
+
+	/// @brief Special key names of the scripts
+	static constexpr KeyName SPECIAL_KEY_NAMES[] = {
+		{ "UP", UP }, { "DOWN", DOWN }, { "LEFT", LEFT }, { "RIGHT", RIGHT },
+		{ "SPACE", SPACE }, { "TAB", TAB }, { "SHIFT", SHIFT }, { "CONTROL", CONTROL },
+		{ "INS", INS }, { "DEL", DEL }, { "HOME", HOME }, { "END", END }, { "PGUP", PGUP }, { "PGDN", PGDN },
+		{ "BACK", BACK }, { "ESCAPE", ESCAPE }, { "ENTER", ENTER }, { "PAUSE", PAUSE },
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////// CONSTRUCTORS & BUILDERS /////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, the script is empty
+	InputScript::InputScript()
+	{
+		uNextEvent = 0;
+	}
+
+	/// @brief Load a script file, its events are added to the current ones
+	/// @param sFilePath Path of the script file
+	/// @return true if the whole file was parsed, false otherwise
+	bool InputScript::LoadFile(const std::string& sFilePath)
+	{
+		std::ifstream fin(sFilePath);
+		if (!fin.is_open()) {
+			std::cerr << "Failed to open file: " << sFilePath << std::endl;
+			return false;
+		}
+		return Parse(fin, sFilePath);
+	}
+
+	/// @brief Parse script lines ("<frame> <press|release|tap> <key>", '#' starts a comment)
+	/// @param input Stream of script lines
+	/// @param sSource Name of the stream in the error messages
+	/// @return true if all lines were parsed, false otherwise (valid lines are still added)
+	bool InputScript::Parse(std::istream& input, const std::string& sSource)
+	{
+		bool bSuccess = true;
+		std::string sLine;
+		for (int nLine = 1; std::getline(input, sLine); nLine++) {
+			sLine = sLine.substr(0, sLine.find('#'));
+			std::istringstream line(sLine);
+			std::string sAction, sKey;
+			uint64_t uFrame = 0;
+			if (!(line >> uFrame)) {
+				if (sLine.find_first_not_of(" \t\r") != std::string::npos) {
+					std::cerr << sSource << ":" << nLine << ": expected a frame number" << std::endl;
+					bSuccess = false;
+				}
+				continue;
+			}
+			line >> sAction >> sKey;
+			const Key eKey = ParseKey(sKey);
+			if (eKey == NONE) {
+				std::cerr << sSource << ":" << nLine << ": unknown key \"" << sKey << "\"" << std::endl;
+				bSuccess = false;
+			}
+			else if (sAction == "press") {
+				AddEvent(uFrame, eKey, true);
+			}
+			else if (sAction == "release") {
+				AddEvent(uFrame, eKey, false);
+			}
+			else if (sAction == "tap") {
+				AddTap(uFrame, eKey);
+			}
+			else {
+				std::cerr << sSource << ":" << nLine << ": unknown action \"" << sAction << "\"" << std::endl;
+				bSuccess = false;
+			}
+		}
+		return bSuccess;
+	}
+
+	/// @brief Add a key event, after the events already added for the same frame
+	/// @param uFrame Frame of the event
+	/// @param eKey Key of the event
+	/// @param bPressed true if the key is pressed, false if it is released
+	void InputScript::AddEvent(const uint64_t uFrame, const Key eKey, const bool bPressed)
+	{
+		const auto itInsert = std::upper_bound(vecEvents.begin(), vecEvents.end(), uFrame,
+			[](const uint64_t uValue, const Event& event) { return uValue < event.uFrame; });
+		vecEvents.insert(itInsert, Event{ uFrame, eKey, bPressed });
+	}
+
+	/// @brief Add a key press and its release
+	/// @param uFrame Frame of the press
+	/// @param eKey Key to tap
+	/// @param uHoldFrames Number of frames between the press and the release (at least 1)
+	void InputScript::AddTap(const uint64_t uFrame, const Key eKey, const uint64_t uHoldFrames)
+	{
+		AddEvent(uFrame, eKey, true);
+		AddEvent(uFrame + std::max<uint64_t>(uHoldFrames, 1), eKey, false);
+	}
+
+	/// @brief Remove all events
+	void InputScript::Clear()
+	{
+		vecEvents.clear();
+		uNextEvent = 0;
+	}
+
+	/// @brief Restart the playback from the first event
+	void InputScript::Rewind()
+	{
+		uNextEvent = 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// GETTERS //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Check if the script has no event
+	bool InputScript::IsEmpty() const
+	{
+		return vecEvents.empty();
+	}
+
+	/// @brief Getter for the number of events
+	size_t InputScript::GetEventCount() const
+	{
+		return vecEvents.size();
+	}
+
+	/// @brief Getter for the frame of the last event (0 if the script is empty)
+	uint64_t InputScript::GetLastFrame() const
+	{
+		return vecEvents.empty() ? 0 : vecEvents.back().uFrame;
+	}
+
+	/// @brief Convert a key name of the scripts to a key (case insensitive)
+	/// @param sName A letter, a digit, F1 to F12 or a special key name (UP, ENTER, ESCAPE, ...)
+	/// @return The key, NONE if the name is unknown
+	Key InputScript::ParseKey(const std::string& sName)
+	{
+		std::string sUpper(sName);
+		std::transform(sUpper.begin(), sUpper.end(), sUpper.begin(),
+			[](const unsigned char cSymbol) { return static_cast<char>(std::toupper(cSymbol)); });
+		if (sUpper.size() == 1 && sUpper[0] >= 'A' && sUpper[0] <= 'Z') {
+			return static_cast<Key>(A + (sUpper[0] - 'A'));
+		}
+		if (sUpper.size() == 1 && sUpper[0] >= '0' && sUpper[0] <= '9') {
+			return static_cast<Key>(K0 + (sUpper[0] - '0'));
+		}
+		if (sUpper.size() >= 2 && sUpper.size() <= 3 && sUpper[0] == 'F'
+			&& std::all_of(sUpper.begin() + 1, sUpper.end(), [](const unsigned char cSymbol) { return std::isdigit(cSymbol); })) {
+			const int nFunction = std::stoi(sUpper.substr(1));
+			return (nFunction >= 1 && nFunction <= 12) ? static_cast<Key>(F1 + nFunction - 1) : NONE;
+		}
+		for (const KeyName& keyName : SPECIAL_KEY_NAMES) {
+			if (sUpper == keyName.sName) {
+				return keyName.eKey;
+			}
+		}
+		return NONE;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// PLAYBACK /////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Apply the pending events up to a frame, before a keyboard sample (KeyboardState::UpdateKeyboard)
+	/// @details A key changes at most once per call, its next events wait for the next sample.
+	/// @param uFrame Current frame
+	/// @param keyboard Keyboard state receiving the events
+	/// @return Number of applied events
+	size_t InputScript::Apply(const uint64_t uFrame, KeyboardState& keyboard)
+	{
+		std::bitset<KEYBOARD_SIZE> changedKeys;
+		size_t uApplied = 0;
+		while (uNextEvent < vecEvents.size() && vecEvents[uNextEvent].uFrame <= uFrame) {
+			const Event& event = vecEvents[uNextEvent];
+			if (changedKeys[event.eKey]) {
+				break;
+			}
+			changedKeys[event.eKey] = true;
+			keyboard.SetKey(event.eKey, event.bPressed);
+			uNextEvent++;
+			uApplied++;
+		}
+		return uApplied;
+	}
+} // namespace app
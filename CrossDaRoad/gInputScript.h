@@ -0,0 +1,69 @@
+#ifndef G_INPUT_SCRIPT_H
+#define G_INPUT_SCRIPT_H
+
+#include "gKey.h"
+#include "gState.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @file gInputScript.h
+ *
+ * @brief Contains input script class
+ *
+ * This file contains the scripted input timeline of the headless mode: key presses and releases at
+ * given frames, built through the API or loaded from a text file with one event per line:
+ *
+ *     # frame  action   key
+ *     30       tap      ENTER
+ *     120      press    UP
+ *     150      release  UP
+ *
+ * Actions are press, release and tap (press, then release one frame later). Keys are letters,
+ * digits, F1 to F12 or the special key names of ParseKey().
+**/
+
+namespace app
+{
+	/// @brief Timeline of scripted key events, fed to the keyboard state frame after frame
+	class InputScript
+	{
+	public:
+		/// @brief Key pressed or released at a frame
+		struct Event
+		{
+			uint64_t uFrame; ///< Frame of the event (0: first frame)
+			Key eKey;        ///< Key of the event
+			bool bPressed;   ///< true if the key is pressed, false if it is released
+		};
+
+	private:
+		std::vector<Event> vecEvents; ///< Events sorted by frame (in insertion order for the same frame)
+		size_t uNextEvent;            ///< Index of the first event not applied yet
+
+	public: // Constructors & Destructor
+		InputScript();
+		~InputScript() = default;
+
+	public: // Builders
+		bool LoadFile(const std::string& sFilePath);
+		bool Parse(std::istream& input, const std::string& sSource = "script");
+		void AddEvent(uint64_t uFrame, Key eKey, bool bPressed);
+		void AddTap(uint64_t uFrame, Key eKey, uint64_t uHoldFrames = 1);
+		void Clear();
+		void Rewind();
+
+	public: // Getters
+		bool IsEmpty() const;
+		size_t GetEventCount() const;
+		uint64_t GetLastFrame() const;
+		static Key ParseKey(const std::string& sName);
+
+	public: // Playback
+		size_t Apply(uint64_t uFrame, KeyboardState& keyboard);
+	};
+} // namespace app
+
+#endif // G_INPUT_SCRIPT_H
@@ -1,7 +1,29 @@
 #include "gKey.h"
-#include <Windows.h>
+#include <array>
 #include <map>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+/// @brief Windows virtual key codes (values of winuser.h), the key codes of the engine on every platform
+enum : uint16_t
+{
+	VK_BACK = 0x08, VK_TAB = 0x09, VK_RETURN = 0x0D, VK_SHIFT = 0x10, VK_CONTROL = 0x11, VK_MENU = 0x12,
+	VK_PAUSE = 0x13, VK_CAPITAL = 0x14, VK_ESCAPE = 0x1B, VK_SPACE = 0x20, VK_PRIOR = 0x21, VK_NEXT = 0x22,
+	VK_END = 0x23, VK_HOME = 0x24, VK_LEFT = 0x25, VK_UP = 0x26, VK_RIGHT = 0x27, VK_DOWN = 0x28,
+	VK_PRINT = 0x2A, VK_INSERT = 0x2D, VK_DELETE = 0x2E, VK_SLEEP = 0x5F,
+	VK_NUMPAD0 = 0x60, VK_NUMPAD1, VK_NUMPAD2, VK_NUMPAD3, VK_NUMPAD4,
+	VK_NUMPAD5, VK_NUMPAD6, VK_NUMPAD7, VK_NUMPAD8, VK_NUMPAD9,
+	VK_MULTIPLY = 0x6A, VK_ADD = 0x6B, VK_SUBTRACT = 0x6D, VK_DECIMAL = 0x6E, VK_DIVIDE = 0x6F,
+	VK_F1 = 0x70, VK_F2, VK_F3, VK_F4, VK_F5, VK_F6, VK_F7, VK_F8, VK_F9, VK_F10, VK_F11, VK_F12,
+	VK_SCROLL = 0x91, VK_VOLUME_DOWN = 0xAE, VK_VOLUME_UP = 0xAF, VK_MEDIA_NEXT_TRACK = 0xB0,
+	VK_MEDIA_PREV_TRACK = 0xB1, VK_MEDIA_STOP = 0xB2, VK_MEDIA_PLAY_PAUSE = 0xB3,
+	VK_OEM_1 = 0xBA, VK_OEM_PLUS = 0xBB, VK_OEM_COMMA = 0xBC, VK_OEM_MINUS = 0xBD, VK_OEM_PERIOD = 0xBE,
+	VK_OEM_2 = 0xBF, VK_OEM_3 = 0xC0, VK_OEM_4 = 0xDB, VK_OEM_5 = 0xDC, VK_OEM_6 = 0xDD,
+	VK_OEM_7 = 0xDE, VK_OEM_8 = 0xDF,
+};
+#endif
+
 /**
  * @file gKey.cpp
  *
@@ -278,6 +300,64 @@ namespace app
 		return mapKeys;
 	}
 
+	/// @brief Virtual key code of a key
+	struct KeyCode
+	{
+		uint8_t uCode; ///< Virtual key code
+		Key eKey;      ///< Key
+	};
+
+	/// @brief Virtual key codes of all keys of CreateMapKey() (when a code is listed in two categories, the first one is kept)
+	static constexpr KeyCode KEY_CODES[] = {
+		{ 0x41, A }, { 0x42, B }, { 0x43, C }, { 0x44, D }, { 0x45, E }, { 0x46, F }, { 0x47, G },
+		{ 0x48, H }, { 0x49, I }, { 0x4A, J }, { 0x4B, K }, { 0x4C, L }, { 0x4D, M }, { 0x4E, N },
+		{ 0x4F, O }, { 0x50, P }, { 0x51, Q }, { 0x52, R }, { 0x53, S }, { 0x54, T }, { 0x55, U },
+		{ 0x56, V }, { 0x57, W }, { 0x58, X }, { 0x59, Y }, { 0x5A, Z },
+		{ 0x30, K0 }, { 0x31, K1 }, { 0x32, K2 }, { 0x33, K3 }, { 0x34, K4 },
+		{ 0x35, K5 }, { 0x36, K6 }, { 0x37, K7 }, { 0x38, K8 }, { 0x39, K9 },
+		{ VK_F1, F1 }, { VK_F2, F2 }, { VK_F3, F3 }, { VK_F4, F4 }, { VK_F5, F5 }, { VK_F6, F6 },
+		{ VK_F7, F7 }, { VK_F8, F8 }, { VK_F9, F9 }, { VK_F10, F10 }, { VK_F11, F11 }, { VK_F12, F12 },
+		{ VK_UP, UP }, { VK_DOWN, DOWN }, { VK_LEFT, LEFT }, { VK_RIGHT, RIGHT },
+		{ VK_SPACE, SPACE }, { VK_TAB, TAB }, { VK_SHIFT, SHIFT }, { VK_CONTROL, CONTROL }, { VK_INSERT, INS },
+		{ VK_DELETE, DEL }, { VK_HOME, HOME }, { VK_END, END }, { VK_PRIOR, PGUP }, { VK_NEXT, PGDN },
+		{ VK_BACK, BACK }, { VK_ESCAPE, ESCAPE }, { VK_RETURN, ENTER }, { VK_PAUSE, PAUSE }, { VK_SCROLL, SCROLL },
+		{ VK_NUMPAD0, NP0 }, { VK_NUMPAD1, NP1 }, { VK_NUMPAD2, NP2 }, { VK_NUMPAD3, NP3 }, { VK_NUMPAD4, NP4 },
+		{ VK_NUMPAD5, NP5 }, { VK_NUMPAD6, NP6 }, { VK_NUMPAD7, NP7 }, { VK_NUMPAD8, NP8 }, { VK_NUMPAD9, NP9 },
+		{ VK_MULTIPLY, NP_MUL }, { VK_DIVIDE, NP_DIV }, { VK_ADD, NP_ADD }, { VK_SUBTRACT, NP_SUB }, { VK_DECIMAL, NP_DECIMAL },
+		{ VK_PRINT, PRINT }, { VK_PAUSE, BREAK }, { VK_MENU, MENU }, { VK_SLEEP, SLEEP }, { VK_CAPITAL, CAPS_LOCK },
+		{ VK_MEDIA_PLAY_PAUSE, MEDIA_PLAY }, { VK_MEDIA_STOP, MEDIA_STOP }, { VK_MEDIA_PREV_TRACK, MEDIA_PREV },
+		{ VK_MEDIA_NEXT_TRACK, MEDIA_NEXT }, { VK_VOLUME_UP, MEDIA_UP }, { VK_VOLUME_DOWN, MEDIA_DOWN },
+		{ VK_OEM_PLUS, EQUAL }, { VK_OEM_COMMA, COMMA }, { VK_OEM_MINUS, MINUS }, { VK_OEM_PERIOD, PERIOD },
+		{ VK_OEM_1, SEMICOLON }, { VK_OEM_2, SLASH }, { VK_OEM_3, BACKTICK }, { VK_OEM_4, LEFT_BRACKET },
+		{ VK_OEM_5, BACKSLASH }, { VK_OEM_6, RIGHT_BRACKET }, { VK_OEM_7, APOSTROPHE }, { VK_OEM_8, VENDOR },
+		{ 0xFF, UNDEFINED },
+	};
+
+	/// @brief Create the table of keys indexed by virtual key code (NONE for the unused codes)
+	/// @return The table, built at compile time
+	static constexpr std::array<Key, KEY_CODE_COUNT> CreateKeyTable()
+	{
+		std::array<Key, KEY_CODE_COUNT> table{};
+		for (const KeyCode& keyCode : KEY_CODES) {
+			if (table[keyCode.uCode] == NONE) {
+				table[keyCode.uCode] = keyCode.eKey;
+			}
+		}
+		return table;
+	}
+
+	/// @brief Keys indexed by virtual key code, same content as CreateMapKey() without any lookup cost
+	static constexpr std::array<Key, KEY_CODE_COUNT> KEY_TABLE = CreateKeyTable();
+	static_assert(KEY_TABLE[VK_PAUSE] == PAUSE && KEY_TABLE[0x00] == NONE, "Key table must match CreateMapKey()");
+
+	/// @brief Translate a virtual key code (e.g. the wParam of WM_KEYDOWN) to a key
+	/// @param nCode The virtual key code.
+	/// @return The key, NONE if the code is not used by the game.
+	Key TranslateKeyCode(const uint16_t nCode)
+	{
+		return nCode < KEY_CODE_COUNT ? KEY_TABLE[nCode] : NONE;
+	}
+
 	/// @brief Check if a key is in the alphabet category. This contains 26 keys {
 	/// @brief     A, B, C, D, E, F, G, H, I, J, K, L, M,
 	/// @brief     N, O, P, Q, R, S, T, U, V, W, X, Y, Z
@@ -1,6 +1,8 @@
 #ifndef G_KEY_H
 #define G_KEY_H
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 
 /**
@@ -9,6 +11,7 @@
  * @brief Contains key enumeration and key map
  *
  * This file contains key enumeration for keyboard input (prototype) and key map for mapping key to its code
+ * (the maps list the key categories, window messages are translated through the table of TranslateKeyCode)
 **/
 
 namespace app
@@ -191,6 +194,9 @@ namespace app
 	std::map<uint16_t, uint8_t> CreateMapKeyVendor();
 	std::map<uint16_t, uint8_t> CreateMapKey();
 
+	constexpr size_t KEY_CODE_COUNT = 256; ///< Number of virtual key codes
+	Key TranslateKeyCode(uint16_t nCode);
+
 	bool IsKeyAlphabet(Key key);
 	bool IsKeyNumeric(Key key);
 	bool IsKeyFunction(Key key);
@@ -0,0 +1,123 @@
+#include "gLatency.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @file gLatency.cpp
+ *
+ * @brief Contains present latency class implementation
+ *
+ * This file implements the input-to-present latency histogram. The buckets double from 1 ms, so a
+ * single frame of extra latency at 60 Hz (about 16.7 ms) moves a sample to the next bucket.
+**/
+
+namespace app
+{
+	/// @brief Names of the latency stages, in the order of PresentLatency::Stage
+	static constexpr const char* STAGE_NAMES[PresentLatency::STAGE_COUNT] = { "queue", "update", "compose", "present" };
+
+	/// @brief Default constructor, no latency recorded
+	PresentLatency::PresentLatency()
+	{
+		Reset();
+	}
+
+	/// @brief Drop all recorded latencies
+	void PresentLatency::Reset()
+	{
+		arrBuckets.fill(0);
+		arrStages.fill(0.0);
+		uSamples = 0;
+		fTotal = 0.0;
+		fMax = 0.0;
+		nLastInput = 0;
+	}
+
+	/// @brief Record the latency of a presented reaction
+	/// @param tag Timestamps of the input event the frame reacts to
+	/// @param nPresented Timestamp of the buffer swap presenting the frame
+	/// @return true if the latency was recorded, false if the tag is empty or was already presented
+	bool PresentLatency::Add(const LatencyTag& tag, const int64_t nPresented)
+	{
+		if (!tag.IsValid() || tag.nReacted == 0 || tag.nInput == nLastInput) {
+			return false;
+		}
+		nLastInput = tag.nInput;
+		const int64_t arrTimes[STAGE_COUNT + 1] = { tag.nInput, tag.nApplied, tag.nReacted, tag.nComposed, nPresented };
+		for (int nStage = 0; nStage < STAGE_COUNT; nStage++) {
+			arrStages[nStage] += static_cast<double>(arrTimes[nStage + 1] - arrTimes[nStage]) * 1e-6;
+		}
+		const double fLatency = static_cast<double>(nPresented - tag.nInput) * 1e-6;
+		size_t uBucket = 0;
+		while (uBucket + 1 < BUCKET_COUNT && fLatency >= GetBucketLimit(uBucket)) {
+			uBucket++;
+		}
+		arrBuckets[uBucket]++;
+		uSamples++;
+		fTotal += fLatency;
+		fMax = std::max(fMax, fLatency);
+		return true;
+	}
+
+	/// @brief Getter for the number of presented reactions
+	size_t PresentLatency::GetCount() const
+	{
+		return uSamples;
+	}
+
+	/// @brief Getter for the mean input-to-present latency (milliseconds)
+	double PresentLatency::GetMean() const
+	{
+		return uSamples > 0 ? fTotal / static_cast<double>(uSamples) : 0.0;
+	}
+
+	/// @brief Getter for the upper bound of the bucket holding a percentile of the latencies
+	/// @param fPercentile Percentile, between 0 and 100
+	/// @return The bucket limit (milliseconds), the longest latency for the last bucket
+	double PresentLatency::GetPercentile(const double fPercentile) const
+	{
+		const double fRank = fPercentile / 100.0 * static_cast<double>(uSamples);
+		size_t uCount = 0;
+		for (size_t uBucket = 0; uBucket + 1 < BUCKET_COUNT; uBucket++) {
+			uCount += arrBuckets[uBucket];
+			if (static_cast<double>(uCount) >= fRank) {
+				return std::min(GetBucketLimit(uBucket), fMax);
+			}
+		}
+		return fMax;
+	}
+
+	/// @brief Getter for the statistics and the histogram as a string
+	std::string PresentLatency::Show() const
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(2);
+		output << "[Input to present: " << uSamples << " reactions, mean " << GetMean() << " ms (";
+		for (int nStage = 0; nStage < STAGE_COUNT; nStage++) {
+			const double fStage = uSamples > 0 ? arrStages[nStage] / static_cast<double>(uSamples) : 0.0;
+			output << (nStage > 0 ? ", " : "") << STAGE_NAMES[nStage] << " " << fStage;
+		}
+		output << "), p50 <= " << GetPercentile(50) << " ms, p95 <= " << GetPercentile(95) << " ms, max " << fMax << " ms]\n";
+		const size_t uLargest = *std::max_element(arrBuckets.begin(), arrBuckets.end());
+		for (size_t uBucket = 0; uBucket < BUCKET_COUNT; uBucket++) {
+			std::ostringstream range;
+			if (uBucket + 1 < BUCKET_COUNT) {
+				range << "< " << GetBucketLimit(uBucket) << " ms";
+			}
+			else {
+				range << ">= " << GetBucketLimit(uBucket - 1) << " ms";
+			}
+			const size_t uBar = uLargest > 0 ? (arrBuckets[uBucket] * 40 + uLargest - 1) / uLargest : 0;
+			output << "  " << std::setw(14) << std::left << range.str() << std::right << std::setw(8) << arrBuckets[uBucket];
+			output << " " << std::string(uBar, '#') << "\n";
+		}
+		return output.str();
+	}
+
+	/// @brief Getter for the upper limit of a bucket (milliseconds)
+	double PresentLatency::GetBucketLimit(const size_t uBucket)
+	{
+		return static_cast<double>(1ull << uBucket);
+	}
+} // namespace app
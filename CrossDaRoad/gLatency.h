@@ -0,0 +1,79 @@
+#ifndef G_LATENCY_H
+#define G_LATENCY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file gLatency.h
+ *
+ * @brief Contains latency tag struct and present latency class
+ *
+ * This file contains the input-to-present latency of the engine. An input event is timestamped when
+ * the window thread receives it, then its tag follows it: applied by a keyboard sample, reacted to by
+ * the game (see GameEngine::MarkInputReaction), composed in a frame and presented by the buffer swap.
+ * The stages tell where the latency comes from: the message loop and the queue, the wait for the next
+ * keyboard sample and update, the frame composition, or the frame pacing and the swap.
+**/
+
+namespace app
+{
+	/// @brief Timestamps of an input event on its way to the screen (see InputEvent::GetTimestamp, 0 if not reached)
+	struct LatencyTag
+	{
+		int64_t nInput = 0;    ///< Received by the window thread
+		int64_t nApplied = 0;  ///< Applied to the keyboard by a keyboard sample
+		int64_t nReacted = 0;  ///< Reacted to by the game
+		int64_t nComposed = 0; ///< Frame of the reaction composed (or published by the simulation thread)
+
+		/// @brief Check if the tag carries an input event
+		bool IsValid() const
+		{
+			return nInput != 0;
+		}
+	};
+
+	/// @brief Histogram of the input-to-present latency, with the mean time of each stage
+	class PresentLatency
+	{
+	public:
+		/// @brief Stages of the latency, between two timestamps of a latency tag
+		enum Stage
+		{
+			QUEUE,   ///< Received to applied (message loop, queue and wait for the keyboard sample)
+			UPDATE,  ///< Applied to reacted (game update)
+			COMPOSE, ///< Reacted to composed (rendering of the frame)
+			PRESENT, ///< Composed to presented (frame pacing, hand-off and buffer swap)
+			STAGE_COUNT
+		};
+		static constexpr size_t BUCKET_COUNT = 9; ///< Buckets of 1, 2, 4, ..., 128 ms and beyond
+
+	private:
+		std::array<size_t, BUCKET_COUNT> arrBuckets; ///< Number of samples per latency bucket
+		std::array<double, STAGE_COUNT> arrStages;   ///< Sum of the stage times (milliseconds)
+		size_t uSamples;  ///< Number of presented reactions
+		double fTotal;    ///< Sum of the latencies (milliseconds)
+		double fMax;      ///< Longest latency (milliseconds)
+		int64_t nLastInput; ///< Input timestamp of the last presented reaction (a frame may be presented twice)
+
+	public: // Constructors & Destructor
+		PresentLatency();
+		~PresentLatency() = default;
+
+	public: // Setters
+		void Reset();
+		bool Add(const LatencyTag& tag, int64_t nPresented);
+
+	public: // Getters
+		size_t GetCount() const;
+		double GetMean() const;
+		double GetPercentile(double fPercentile) const;
+		std::string Show() const;
+
+	private:
+		static double GetBucketLimit(size_t uBucket);
+	};
+} // namespace app
+
+#endif // G_LATENCY_H
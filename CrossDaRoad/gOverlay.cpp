@@ -0,0 +1,245 @@
+#include "gOverlay.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @file gOverlay.cpp
+ *
+ * @brief Contains performance overlay class implementation
+ *
+ * This file implements the performance overlay. Text uses a 3x5 pixel font stored as 15-bit masks
+ * (5 rows of 3 bits, top row first), so the engine does not depend on the game fonts.
+**/
+
+namespace app
+{
+	static constexpr int32_t GLYPH_WIDTH = 3;  ///< Width of a glyph of the overlay font
+	static constexpr int32_t GLYPH_HEIGHT = 5; ///< Height of a glyph of the overlay font
+	static constexpr int32_t LINE_HEIGHT = 6;  ///< Distance between two lines of text
+	static constexpr int32_t BAR_X = 28;       ///< Left of the phase bars (relative to the panel)
+	static constexpr int32_t BAR_WIDTH = 44;   ///< Longest phase bar
+	static constexpr float BAR_SCALE = 4.0f;   ///< Pixels per millisecond of the phase bars
+
+	/// @brief Glyphs of '0' to '9'
+	static constexpr uint16_t DIGIT_GLYPHS[10] = {
+		0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, 0x7BEF, 0x7BCF,
+	};
+	/// @brief Glyphs of 'A' to 'Z'
+	static constexpr uint16_t LETTER_GLYPHS[26] = {
+		0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4, 0x396B, 0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED,
+		0x6B6D, 0x2B6A, 0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F, 0x5B6A, 0x5BFD, 0x5AAD, 0x5A92, 0x72A7,
+	};
+	/// @brief Phases shown as bars (FRAME is the graph, PAUSE is empty while the overlay is visible)
+	static constexpr FrameProfiler::Phase BAR_PHASES[] = {
+		FrameProfiler::INPUT, FrameProfiler::UPDATE, FrameProfiler::RENDER, FrameProfiler::UPLOAD, FrameProfiler::WAIT,
+	};
+
+	/// @brief Short form of a count (e.g. 1234567 -> "1.2M")
+	static std::string ShowCount(const uint64_t uCount)
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(1);
+		if (uCount >= 1000000) {
+			output << static_cast<double>(uCount) / 1e6 << "M";
+		}
+		else if (uCount >= 10000) {
+			output << std::setprecision(0) << static_cast<double>(uCount) / 1e3 << "K";
+		}
+		else {
+			output << uCount;
+		}
+		return output.str();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////// CONSTRUCTORS & SETTERS //////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, the overlay is hidden
+	PerformanceOverlay::PerformanceOverlay()
+	{
+		bVisible = false;
+		bSaved = false;
+		vecSaved.resize(static_cast<size_t>(WIDTH) * HEIGHT);
+	}
+
+	/// @brief Setter for the visibility
+	/// @param bShow true to draw the overlay on the next frames
+	void PerformanceOverlay::SetVisible(const bool bShow)
+	{
+		bVisible = bShow;
+	}
+
+	/// @brief Show the overlay if hidden, hide it otherwise
+	/// @return The new visibility
+	bool PerformanceOverlay::Toggle()
+	{
+		bVisible = !bVisible;
+		return bVisible;
+	}
+
+	/// @brief Getter for the visibility
+	bool PerformanceOverlay::IsVisible() const
+	{
+		return bVisible;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// DRAWING //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Draw the overlay on the draw target of the texture, saving the pixels under it first
+	/// @param texture The texture whose draw target is about to be presented
+	/// @param profiler The profiler of the engine loop (frame time graph and phase bars)
+	/// @param stats The other statistics to show
+	/// @return true if the overlay was drawn, false if it is hidden or the target is too small
+	bool PerformanceOverlay::Draw(Texture& texture, const FrameProfiler& profiler, const OverlayStats& stats)
+	{
+		const Sprite* pTarget = texture.GetDrawTarget();
+		if (!bVisible || !pTarget || pTarget->Width() < POS_X + WIDTH || pTarget->Height() < POS_Y + HEIGHT) {
+			return false;
+		}
+		Save(pTarget);
+		const Pixel::Mode eMode = texture.GetPixelMode();
+		const float fBlend = texture.GetBlendFactor();
+
+		// Panel
+		texture.SetPixelMode(Pixel::ALPHA);
+		texture.SetBlendFactor(0.75f);
+		DrawRect(texture, POS_X, POS_Y, WIDTH, HEIGHT, BLACK);
+		texture.SetPixelMode(Pixel::NORMAL);
+
+		// Counters
+		const float fFrameTime = profiler.GetFrameCount() > 0 ? profiler.GetFrame(0)[FrameProfiler::FRAME] : 0.0f;
+		std::ostringstream line;
+		line << std::fixed << std::setprecision(1) << "FPS " << stats.nFPS << "  " << fFrameTime << "MS";
+		DrawString(texture, POS_X + 2, POS_Y + 2, line.str(), WHITE);
+		DrawString(texture, POS_X + 2, POS_Y + 2 + LINE_HEIGHT, "DRAW " + ShowCount(stats.uDrawCalls) + "  PIX " + ShowCount(stats.uDrawnPixels), WHITE);
+		line.str("");
+		line << "MEM ";
+		if (stats.uMemory > 0) {
+			line << static_cast<double>(stats.uMemory) / (1024.0 * 1024.0) << "MB";
+		}
+		else {
+			line << "-";
+		}
+		DrawString(texture, POS_X + 2, POS_Y + 2 + 2 * LINE_HEIGHT, line.str(), WHITE);
+
+		// Frame time graph, oldest frame on the left, the frame budget is at mid-height
+		const int32_t nGraphX = POS_X + 2;
+		const int32_t nGraphY = POS_Y + 3 + 3 * LINE_HEIGHT;
+		const int32_t nGraphWidth = WIDTH - 4;
+		const float fBudget = stats.fFrameBudget > 0 ? stats.fFrameBudget : 1000.0f / 60.0f;
+		const float fPixelsPerMs = static_cast<float>(GRAPH_HEIGHT) / (2.0f * fBudget);
+		DrawRect(texture, nGraphX, nGraphY, nGraphWidth, GRAPH_HEIGHT, VERY_DARK_GREY);
+		const size_t uColumns = std::min(profiler.GetFrameCount(), static_cast<size_t>(nGraphWidth));
+		for (size_t uAge = 0; uAge < uColumns; uAge++) {
+			const float fTime = profiler.GetFrame(uAge)[FrameProfiler::FRAME];
+			const int32_t nHeight = std::clamp(static_cast<int32_t>(fTime * fPixelsPerMs + 0.5f), 1, GRAPH_HEIGHT);
+			const Pixel pixel = fTime <= fBudget * 1.05f ? GREEN : (fTime <= fBudget * 2.0f ? YELLOW : RED);
+			const int32_t nColumn = nGraphX + nGraphWidth - 1 - static_cast<int32_t>(uAge);
+			DrawRect(texture, nColumn, nGraphY + GRAPH_HEIGHT - nHeight, 1, nHeight, pixel);
+		}
+		DrawRect(texture, nGraphX, nGraphY + GRAPH_HEIGHT / 2, nGraphWidth, 1, DARK_GREY);
+
+		// Phase bars, averaged over the last frames
+		const size_t uFrames = std::min(profiler.GetFrameCount(), AVERAGED_FRAMES);
+		int32_t nRowY = nGraphY + GRAPH_HEIGHT + 2;
+		for (const FrameProfiler::Phase ePhase : BAR_PHASES) {
+			float fMean = 0;
+			for (size_t uAge = 0; uAge < uFrames; uAge++) {
+				fMean += profiler.GetFrame(uAge)[ePhase];
+			}
+			fMean = uFrames > 0 ? fMean / static_cast<float>(uFrames) : 0.0f;
+			const int32_t nLength = std::clamp(static_cast<int32_t>(fMean * BAR_SCALE + 0.5f), 0, BAR_WIDTH);
+			DrawString(texture, POS_X + 2, nRowY, FrameProfiler::GetPhaseName(ePhase), LIGHT_GREY);
+			DrawRect(texture, POS_X + BAR_X, nRowY, nLength, GLYPH_HEIGHT, ePhase == FrameProfiler::WAIT ? DARK_CYAN : CYAN);
+			line.str("");
+			line << std::setprecision(2) << fMean;
+			DrawString(texture, POS_X + BAR_X + BAR_WIDTH + 2, nRowY, line.str(), LIGHT_GREY);
+			nRowY += LINE_HEIGHT;
+		}
+
+		texture.SetPixelMode(eMode);
+		texture.SetBlendFactor(fBlend);
+		return true;
+	}
+
+	/// @brief Put back the pixels saved under the overlay (the target may be another buffer with the same content)
+	/// @param pTarget The sprite to restore
+	/// @return true if pixels were restored, false if nothing was saved
+	bool PerformanceOverlay::Restore(Sprite* pTarget)
+	{
+		if (!bSaved || !pTarget) {
+			return false;
+		}
+		bSaved = false;
+		for (int32_t nRow = 0; nRow < HEIGHT; nRow++) {
+			const Pixel* pSource = vecSaved.data() + static_cast<size_t>(nRow) * WIDTH;
+			Pixel* pDestination = pTarget->GetData() + static_cast<size_t>(POS_Y + nRow) * pTarget->Width() + POS_X;
+			std::copy_n(pSource, WIDTH, pDestination);
+		}
+		return true;
+	}
+
+	/// @brief Save the pixels under the overlay panel
+	void PerformanceOverlay::Save(const Sprite* pTarget)
+	{
+		for (int32_t nRow = 0; nRow < HEIGHT; nRow++) {
+			const Pixel* pSource = pTarget->GetData() + static_cast<size_t>(POS_Y + nRow) * pTarget->Width() + POS_X;
+			std::copy_n(pSource, WIDTH, vecSaved.data() + static_cast<size_t>(nRow) * WIDTH);
+		}
+		bSaved = true;
+	}
+
+	/// @brief Fill a rectangle with the current pixel mode of the texture
+	void PerformanceOverlay::DrawRect(Texture& texture, const int32_t nX, const int32_t nY, const int32_t nWidth, const int32_t nHeight, const Pixel pixel)
+	{
+		for (int32_t nPosY = nY; nPosY < nY + nHeight; nPosY++) {
+			for (int32_t nPosX = nX; nPosX < nX + nWidth; nPosX++) {
+				texture.Draw(nPosX, nPosY, pixel);
+			}
+		}
+	}
+
+	/// @brief Draw a line of text with the overlay font (unknown symbols are blank)
+	/// @return The X-coordinate after the text
+	int32_t PerformanceOverlay::DrawString(Texture& texture, int32_t nX, const int32_t nY, const std::string& sText, const Pixel pixel)
+	{
+		for (const char cSymbol : sText) {
+			const uint16_t uGlyph = GetGlyph(cSymbol);
+			for (int32_t nRow = 0; nRow < GLYPH_HEIGHT; nRow++) {
+				for (int32_t nColumn = 0; nColumn < GLYPH_WIDTH; nColumn++) {
+					const int nBit = (GLYPH_HEIGHT - 1 - nRow) * GLYPH_WIDTH + (GLYPH_WIDTH - 1 - nColumn);
+					if (uGlyph >> nBit & 1) {
+						texture.Draw(nX + nColumn, nY + nRow, pixel);
+					}
+				}
+			}
+			nX += GLYPH_WIDTH + 1;
+		}
+		return nX;
+	}
+
+	/// @brief Getter for the 15-bit mask of a symbol of the overlay font
+	uint16_t PerformanceOverlay::GetGlyph(const char cSymbol)
+	{
+		const char cUpper = static_cast<char>(std::toupper(static_cast<unsigned char>(cSymbol)));
+		if (cUpper >= '0' && cUpper <= '9') {
+			return DIGIT_GLYPHS[cUpper - '0'];
+		}
+		if (cUpper >= 'A' && cUpper <= 'Z') {
+			return LETTER_GLYPHS[cUpper - 'A'];
+		}
+		switch (cUpper) {
+			case '.': return 0x0002;
+			case ':': return 0x0410;
+			case '/': return 0x12A4;
+			case '-': return 0x01C0;
+			case '%': return 0x52A5;
+			default: return 0x0000;
+		}
+	}
+} // namespace app
@@ -0,0 +1,71 @@
+#ifndef G_OVERLAY_H
+#define G_OVERLAY_H
+
+#include "gPixel.h"
+#include "gProfiler.h"
+#include "gSprite.h"
+#include "gTexture.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file gOverlay.h
+ *
+ * @brief Contains performance overlay statistics struct and performance overlay class
+ *
+ * This file contains the performance overlay of the engine. It is drawn into the frame just before it
+ * is presented (FPS, frame time graph, per-phase bars, draw counts and memory) with a built-in pixel
+ * font, and the pixels under it are restored right after, so the game never sees it.
+**/
+
+namespace app
+{
+	/// @brief Statistics shown by the performance overlay besides the profiled phases
+	struct OverlayStats
+	{
+		int nFPS;              ///< Frames per second of the last second
+		float fFrameBudget;    ///< Frame period targeted by the pacer (in milliseconds, 0 if uncapped)
+		uint32_t uDrawCalls;   ///< Sprite blits and clears since the last presented frame
+		uint64_t uDrawnPixels; ///< Pixels written since the last presented frame
+		uint64_t uMemory;      ///< Working set of the process (in bytes, 0 if unknown)
+	};
+
+	/// @brief In-frame performance overlay, drawn with the engine texture and erased after presenting
+	class PerformanceOverlay
+	{
+	public:
+		static constexpr int32_t POS_X = 2;          ///< Left of the overlay panel
+		static constexpr int32_t POS_Y = 2;          ///< Top of the overlay panel
+		static constexpr int32_t WIDTH = 100;        ///< Width of the overlay panel
+		static constexpr int32_t HEIGHT = 74;        ///< Height of the overlay panel
+		static constexpr int32_t GRAPH_HEIGHT = 20;  ///< Height of the frame time graph
+		static constexpr size_t AVERAGED_FRAMES = 32; ///< Number of frames averaged by the phase bars
+
+	private:
+		bool bVisible;                ///< If the overlay is drawn
+		std::vector<Pixel> vecSaved;  ///< Pixels under the overlay panel, restored after presenting
+		bool bSaved;                  ///< If vecSaved holds the pixels of the current frame
+
+	public: // Constructors & Destructor
+		PerformanceOverlay();
+		~PerformanceOverlay() = default;
+
+	public: // Setters & Getters
+		void SetVisible(bool bShow);
+		bool Toggle();
+		bool IsVisible() const;
+
+	public: // Drawing
+		bool Draw(Texture& texture, const FrameProfiler& profiler, const OverlayStats& stats);
+		bool Restore(Sprite* pTarget);
+
+	private:
+		void Save(const Sprite* pTarget);
+		static void DrawRect(Texture& texture, int32_t nX, int32_t nY, int32_t nWidth, int32_t nHeight, Pixel pixel);
+		static int32_t DrawString(Texture& texture, int32_t nX, int32_t nY, const std::string& sText, Pixel pixel);
+		static uint16_t GetGlyph(char cSymbol);
+	};
+} // namespace app
+
+#endif // G_OVERLAY_H
@@ -0,0 +1,95 @@
+#include "gPlatform.h"
+#include <chrono>
+
+#ifdef _WIN32
+#pragma comment(lib, "psapi.lib")
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+/**
+ * @file gPlatform.cpp
+ *
+ * @brief Contains wake event class and process queries implementation
+ *
+ * This file implements the wake event on the standard library, so the window thread, the engine thread
+ * and the simulation thread signal each other the same way on every platform, and the process queries
+ * with the API of each platform (zero where there is none).
+**/
+
+namespace app
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////// WAKE EVENT //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Signals the event, waking one waiting thread (or the next call to Wait)
+	void WakeEvent::Set()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			bSignaled = true;
+		}
+		condition.notify_one();
+	}
+
+	/// @brief Waits until the event is signaled or the timeout expires, and resets the event
+	/// @param uTimeout Longest wait (milliseconds)
+	/// @return True if the event was signaled, false on timeout
+	bool WakeEvent::Wait(const uint32_t uTimeout)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		const bool bWoken = condition.wait_for(lock, std::chrono::milliseconds(uTimeout), [this]() { return bSignaled; });
+		bSignaled = false;
+		return bWoken;
+	}
+
+	/// @brief Drops a signal that no thread waited for
+	void WakeEvent::Reset()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		bSignaled = false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////// PLATFORM ///////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	namespace platform
+	{
+		/// @brief Check if the platform has the windowed mode (window, OpenGL texture, sound)
+		bool IsWindowSupported()
+		{
+#ifdef _WIN32
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/// @brief Getter for the physical memory used by the process (working set, resident set on Linux)
+		/// @return Memory in bytes, 0 if unknown
+		size_t GetProcessMemory()
+		{
+#ifdef _WIN32
+			PROCESS_MEMORY_COUNTERS memory{};
+			if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory))) {
+				return memory.WorkingSetSize;
+			}
+			return 0;
+#elif defined(__linux__)
+			std::ifstream statm("/proc/self/statm");
+			size_t uTotalPages = 0;
+			size_t uResidentPages = 0;
+			if (!(statm >> uTotalPages >> uResidentPages)) {
+				return 0;
+			}
+			return uResidentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+			return 0;
+#endif
+		}
+	} // namespace platform
+} // namespace app
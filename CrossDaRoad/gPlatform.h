@@ -0,0 +1,53 @@
+#ifndef G_PLATFORM_H
+#define G_PLATFORM_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * @file gPlatform.h
+ *
+ * @brief Contains window handle type, wake event class and process queries of the platform layer
+ *
+ * This file contains what the engine needs from the operating system besides the window itself. Windowed
+ * mode (window, OpenGL texture, sound, file dialogs) needs Windows; other platforms build the engine for
+ * headless runs only, where these parts are stubbed out.
+**/
+
+namespace app
+{
+#ifdef _WIN32
+	using WindowHandle = HWND; ///< Handle of the game window
+#else
+	using WindowHandle = void*; ///< Handle of the game window (no window outside Windows)
+#endif
+
+	/// @brief Auto-reset event: Set() wakes one waiting thread, or the next one to wait
+	class WakeEvent
+	{
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool bSignaled = false; ///< Set and not consumed by a wait yet
+
+	public: // Signaling
+		void Set();
+		bool Wait(uint32_t uTimeout);
+		void Reset();
+	};
+
+	/// @brief Platform queries
+	namespace platform
+	{
+		bool IsWindowSupported();
+		size_t GetProcessMemory();
+	}
+} // namespace app
+
+#endif // G_PLATFORM_H
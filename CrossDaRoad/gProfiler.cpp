@@ -0,0 +1,304 @@
+#include "gProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @file gProfiler.cpp
+ *
+ * @brief Contains frame profiler class implementation
+ *
+ * This file implements the frame profiler. Recording a tick is one clock read and one store, the phase
+ * durations are computed once per frame, and the statistics are only computed when they are requested.
+**/
+
+namespace app
+{
+	/// @brief Ticks bounding a phase of a frame
+	struct PhaseBounds
+	{
+		const char* sName;   ///< Name of the phase
+		engine::Tick eBegin; ///< Tick starting the phase
+		engine::Tick eEnd;   ///< Tick ending the phase
+	};
+
+	/// @brief Bounds of all phases (key: FrameProfiler::Phase), input is bounded once per keyboard sample
+	static constexpr PhaseBounds PHASE_BOUNDS[FrameProfiler::PHASE_COUNT] = {
+		{ "input", engine::PRE_WINDOW_EVENT, engine::AFTER_LOAD_KEYBOARD_EVENT },
+		{ "update", engine::BEFORE_UPDATE_EVENT, engine::AFTER_UPDATE_EVENT },
+		{ "render", engine::BEFORE_SCENE_RENDER_EVENT, engine::AFTER_SCENE_RENDER_EVENT },
+		{ "upload", engine::AFTER_SCENE_RENDER_EVENT, engine::AFTER_RENDER_EVENT },
+		{ "wait", engine::BEFORE_POST_PROCCESSING_EVENT, engine::AFTER_POST_PROCCESSING_EVENT },
+		{ "pause", engine::AFTER_POST_PROCCESSING_EVENT, engine::POST_RUNNING_EVENT },
+		{ "frame", engine::PRE_RUNNING_EVENT, engine::POST_RUNNING_EVENT },
+	};
+
+	/// @brief Check if a tick bounds a phase of the engine loop
+	static bool IsFrameTick(const engine::Tick eTick)
+	{
+		switch (eTick) {
+			case engine::PRE_RUNNING_EVENT:
+			case engine::PRE_WINDOW_EVENT:
+			case engine::AFTER_LOAD_KEYBOARD_EVENT:
+			case engine::BEFORE_UPDATE_EVENT:
+			case engine::AFTER_UPDATE_EVENT:
+			case engine::BEFORE_SCENE_RENDER_EVENT:
+			case engine::AFTER_SCENE_RENDER_EVENT:
+			case engine::AFTER_RENDER_EVENT:
+			case engine::BEFORE_POST_PROCCESSING_EVENT:
+			case engine::AFTER_POST_PROCCESSING_EVENT:
+			case engine::POST_RUNNING_EVENT:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/// @brief Current time of the monotonic clock in nanoseconds
+	static int64_t GetTimestamp()
+	{
+		const auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+	}
+
+	/// @brief Nearest-rank percentile of sorted durations
+	static float GetPercentile(const std::vector<float>& vecSorted, const float fPercent)
+	{
+		const size_t uRank = static_cast<size_t>(fPercent / 100.0f * static_cast<float>(vecSorted.size()) + 0.999f);
+		return vecSorted[std::clamp<size_t>(uRank, 1, vecSorted.size()) - 1];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////// CONSTRUCTORS & SETTERS //////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Constructor
+	/// @param uCapacity Number of frames kept in the ring buffer
+	FrameProfiler::FrameProfiler(const size_t uCapacity)
+	{
+		bEnabled = true;
+		SetCapacity(uCapacity);
+	}
+
+	/// @brief Setter for the recording state
+	/// @param bEnable true to record the ticks, false to ignore them
+	void FrameProfiler::SetEnabled(const bool bEnable)
+	{
+		bEnabled = bEnable;
+	}
+
+	/// @brief Setter for the number of frames kept, recorded frames are cleared
+	/// @param uCapacity Number of frames kept in the ring buffer (at least 1)
+	void FrameProfiler::SetCapacity(const size_t uCapacity)
+	{
+		vecFrames.assign(std::max<size_t>(uCapacity, 1), FrameTimes{});
+		Reset();
+	}
+
+	/// @brief Clear recorded frames
+	void FrameProfiler::Reset()
+	{
+		arrTicks.fill(-1);
+		nInputTime = 0;
+		nUpdateInputTime = 0;
+		uNextFrame = 0;
+		uFrameCount = 0;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// RECORDER /////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Timestamp a tick of the current frame, the frame is recorded at POST_RUNNING_EVENT
+	/// @param eTick The tick broadcast by the engine loop
+	void FrameProfiler::Mark(const engine::Tick eTick)
+	{
+		if (!IsFrameTick(eTick) || !bEnabled) {
+			return;
+		}
+		if (eTick == engine::PRE_RUNNING_EVENT) {
+			arrTicks.fill(-1);
+			nInputTime = 0;
+			nUpdateInputTime = 0;
+		}
+		arrTicks[eTick] = GetTimestamp();
+		if (eTick == engine::AFTER_LOAD_KEYBOARD_EVENT) {
+			EndInput();
+		}
+		if (eTick == engine::POST_RUNNING_EVENT) {
+			EndFrame();
+		}
+	}
+
+	/// @brief Add the keyboard sample that just ended to the input time of the current frame
+	/// @details Fixed-rate steps sample the keyboard inside the update phase, their time is moved out of it.
+	/// Samples of the pause loop are not closed by AFTER_LOAD_KEYBOARD_EVENT and stay in the pause phase.
+	void FrameProfiler::EndInput()
+	{
+		const int64_t nBegin = arrTicks[PHASE_BOUNDS[INPUT].eBegin];
+		const int64_t nEnd = arrTicks[PHASE_BOUNDS[INPUT].eEnd];
+		if (nBegin < 0 || nEnd < nBegin) {
+			return;
+		}
+		nInputTime += nEnd - nBegin;
+		const int64_t nUpdateBegin = arrTicks[PHASE_BOUNDS[UPDATE].eBegin];
+		if (nUpdateBegin >= 0 && nBegin >= nUpdateBegin) {
+			nUpdateInputTime += nEnd - nBegin;
+		}
+		arrTicks[PHASE_BOUNDS[INPUT].eBegin] = -1;
+	}
+
+	/// @brief Compute the phase durations of the current frame and push them in the ring buffer
+	void FrameProfiler::EndFrame()
+	{
+		FrameTimes& times = vecFrames[uNextFrame];
+		for (int nPhase = 0; nPhase < PHASE_COUNT; nPhase++) {
+			const int64_t nBegin = arrTicks[PHASE_BOUNDS[nPhase].eBegin];
+			const int64_t nEnd = arrTicks[PHASE_BOUNDS[nPhase].eEnd];
+			times[nPhase] = (nBegin < 0 || nEnd < nBegin) ? 0.0f : static_cast<float>(nEnd - nBegin) * 1e-6f;
+		}
+		times[INPUT] = static_cast<float>(nInputTime) * 1e-6f;
+		times[UPDATE] = std::max(times[UPDATE] - static_cast<float>(nUpdateInputTime) * 1e-6f, 0.0f);
+		uNextFrame = (uNextFrame + 1) % vecFrames.size();
+		uFrameCount = std::min(uFrameCount + 1, vecFrames.size());
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// GETTERS //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for the recording state
+	bool FrameProfiler::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/// @brief Getter for the number of recorded frames
+	size_t FrameProfiler::GetFrameCount() const
+	{
+		return uFrameCount;
+	}
+
+	/// @brief Getter for a recorded frame
+	/// @param uAge 0 for the last recorded frame, 1 for the one before, ... (clamped to the oldest)
+	const FrameProfiler::FrameTimes& FrameProfiler::GetFrame(const size_t uAge) const
+	{
+		const size_t uCapacity = vecFrames.size();
+		const size_t uOffset = std::min(uAge, uFrameCount > 0 ? uFrameCount - 1 : 0);
+		return vecFrames[(uNextFrame + 2 * uCapacity - 1 - uOffset) % uCapacity];
+	}
+
+	/// @brief Getter for the statistics of a phase over the recorded frames
+	FrameProfiler::PhaseStats FrameProfiler::GetStats(const Phase ePhase) const
+	{
+		PhaseStats stats{ GetPhaseName(ePhase), uFrameCount, 0, 0, 0, 0, 0, 0 };
+		if (uFrameCount == 0) {
+			return stats;
+		}
+		std::vector<float> vecSorted(uFrameCount);
+		double fSum = 0;
+		for (size_t uAge = 0; uAge < uFrameCount; uAge++) {
+			vecSorted[uAge] = GetFrame(uAge)[ePhase];
+			fSum += vecSorted[uAge];
+		}
+		std::sort(vecSorted.begin(), vecSorted.end());
+		stats.fMin = vecSorted.front();
+		stats.fMean = static_cast<float>(fSum / static_cast<double>(uFrameCount));
+		stats.fP50 = GetPercentile(vecSorted, 50);
+		stats.fP95 = GetPercentile(vecSorted, 95);
+		stats.fP99 = GetPercentile(vecSorted, 99);
+		stats.fMax = vecSorted.back();
+		return stats;
+	}
+
+	/// @brief Getter for the name of a phase
+	const char* FrameProfiler::GetPhaseName(const Phase ePhase)
+	{
+		if (ePhase < 0 || ePhase >= PHASE_COUNT) {
+			return "unknown";
+		}
+		return PHASE_BOUNDS[ePhase].sName;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// REPORTS //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for the statistics of all phases as a table (in milliseconds)
+	std::string FrameProfiler::ShowStats() const
+	{
+		std::ostringstream output;
+		output << std::fixed << std::setprecision(3);
+		output << "[Profile: " << uFrameCount << " frames, ms]" << std::endl;
+		output << std::left << std::setw(8) << "phase" << std::right;
+		for (const char* sColumn : { "min", "mean", "p50", "p95", "p99", "max" }) {
+			output << std::setw(10) << sColumn;
+		}
+		output << std::endl;
+		for (int nPhase = 0; nPhase < PHASE_COUNT; nPhase++) {
+			const PhaseStats stats = GetStats(static_cast<Phase>(nPhase));
+			output << std::left << std::setw(8) << stats.sName << std::right;
+			for (const float fValue : { stats.fMin, stats.fMean, stats.fP50, stats.fP95, stats.fP99, stats.fMax }) {
+				output << std::setw(10) << fValue;
+			}
+			output << std::endl;
+		}
+		return output.str();
+	}
+
+	/// @brief Write the recorded frames as CSV, oldest first (one row per frame, durations in milliseconds)
+	/// @param sFilePath Path of the CSV file
+	/// @return true if the file was written, false otherwise
+	bool FrameProfiler::DumpCSV(const std::string& sFilePath) const
+	{
+		std::ofstream fout(sFilePath);
+		if (!fout.is_open()) {
+			std::cerr << "Failed to open file: " << sFilePath << std::endl;
+			return false;
+		}
+		fout << "frame";
+		for (int nPhase = 0; nPhase < PHASE_COUNT; nPhase++) {
+			fout << "," << PHASE_BOUNDS[nPhase].sName;
+		}
+		fout << "\n" << std::fixed << std::setprecision(4);
+		for (size_t uIndex = 0; uIndex < uFrameCount; uIndex++) {
+			const FrameTimes& times = GetFrame(uFrameCount - 1 - uIndex);
+			fout << uIndex;
+			for (const float fTime : times) {
+				fout << "," << fTime;
+			}
+			fout << "\n";
+		}
+		return static_cast<bool>(fout);
+	}
+
+	/// @brief Write the statistics and the recorded frames as JSON (durations in milliseconds)
+	/// @param sFilePath Path of the JSON file
+	/// @return true if the file was written, false otherwise
+	bool FrameProfiler::DumpJSON(const std::string& sFilePath) const
+	{
+		std::ofstream fout(sFilePath);
+		if (!fout.is_open()) {
+			std::cerr << "Failed to open file: " << sFilePath << std::endl;
+			return false;
+		}
+		fout << std::fixed << std::setprecision(4);
+		fout << "{\n  \"unit\": \"ms\",\n  \"frames\": " << uFrameCount << ",\n  \"phases\": {\n";
+		for (int nPhase = 0; nPhase < PHASE_COUNT; nPhase++) {
+			const PhaseStats stats = GetStats(static_cast<Phase>(nPhase));
+			fout << "    \"" << stats.sName << "\": { ";
+			fout << "\"min\": " << stats.fMin << ", \"mean\": " << stats.fMean;
+			fout << ", \"p50\": " << stats.fP50 << ", \"p95\": " << stats.fP95;
+			fout << ", \"p99\": " << stats.fP99 << ", \"max\": " << stats.fMax << ", \"samples\": [";
+			for (size_t uIndex = 0; uIndex < uFrameCount; uIndex++) {
+				fout << (uIndex ? ", " : "") << GetFrame(uFrameCount - 1 - uIndex)[nPhase];
+			}
+			fout << "] }" << (nPhase + 1 < PHASE_COUNT ? "," : "") << "\n";
+		}
+		fout << "  }\n}\n";
+		return static_cast<bool>(fout);
+	}
+} // namespace app
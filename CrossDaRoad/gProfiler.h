@@ -0,0 +1,94 @@
+#ifndef G_PROFILER_H
+#define G_PROFILER_H
+
+#include "gConst.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file gProfiler.h
+ *
+ * @brief Contains frame profiler class
+ *
+ * This file contains the frame profiler of the engine loop. Each engine::Tick broadcast by the loop is
+ * timestamped with a monotonic clock, the durations of the phases between ticks are kept for the last
+ * frames in a ring buffer, and summarized as min, mean, p50, p95, p99 and max per phase.
+**/
+
+namespace app
+{
+	/// @brief Per-phase timing of the engine loop over the last frames
+	class FrameProfiler
+	{
+	public:
+		/// @brief Phases of a frame, each one measured between two engine ticks
+		enum Phase
+		{
+			INPUT,   ///< Keyboard loading, summed over the samples of the frame (PRE_WINDOW_EVENT to AFTER_LOAD_KEYBOARD_EVENT)
+			UPDATE,  ///< Game update, without the keyboard samples of its steps (BEFORE_UPDATE_EVENT to AFTER_UPDATE_EVENT)
+			RENDER,  ///< Scene drawing (BEFORE_SCENE_RENDER_EVENT to AFTER_SCENE_RENDER_EVENT)
+			UPLOAD,  ///< Texture upload and present, or frame publishing (AFTER_SCENE_RENDER_EVENT to AFTER_RENDER_EVENT)
+			WAIT,    ///< Frame pacing (BEFORE_POST_PROCCESSING_EVENT to AFTER_POST_PROCCESSING_EVENT)
+			PAUSE,   ///< Pause loop (AFTER_POST_PROCCESSING_EVENT to POST_RUNNING_EVENT)
+			FRAME,   ///< Whole frame (PRE_RUNNING_EVENT to POST_RUNNING_EVENT)
+			PHASE_COUNT,
+		};
+
+		/// @brief Summary of one phase over the recorded frames (durations in milliseconds)
+		struct PhaseStats
+		{
+			const char* sName; ///< Name of the phase
+			size_t uSamples;   ///< Number of recorded frames
+			float fMin;        ///< Shortest duration
+			float fMean;       ///< Mean duration
+			float fP50;        ///< Median duration
+			float fP95;        ///< 95th percentile duration
+			float fP99;        ///< 99th percentile duration
+			float fMax;        ///< Longest duration
+		};
+
+		using FrameTimes = std::array<float, PHASE_COUNT>; ///< Durations of all phases of a frame (in milliseconds)
+		static constexpr size_t DEFAULT_CAPACITY = 1024;    ///< Default number of frames kept
+
+	private:
+		std::array<int64_t, engine::TICK_COUNT> arrTicks; ///< Timestamps of the ticks of the current frame (ns, -1 if unset)
+		std::vector<FrameTimes> vecFrames;                ///< Ring buffer of the last frames
+		size_t uNextFrame;                                ///< Ring index of the next recorded frame
+		size_t uFrameCount;                               ///< Number of recorded frames (up to capacity)
+		int64_t nInputTime;                               ///< Keyboard loading time of the current frame (ns)
+		int64_t nUpdateInputTime;                         ///< Part of the keyboard loading time inside the update phase (ns)
+		bool bEnabled;                                    ///< If ticks are recorded
+
+	public: // Constructors & Destructor
+		FrameProfiler(size_t uCapacity = DEFAULT_CAPACITY);
+		~FrameProfiler() = default;
+
+	public: // Setters
+		void SetEnabled(bool bEnable);
+		void SetCapacity(size_t uCapacity);
+		void Reset();
+
+	public: // Recorder
+		void Mark(engine::Tick eTick);
+
+	public: // Getters
+		bool IsEnabled() const;
+		size_t GetFrameCount() const;
+		const FrameTimes& GetFrame(size_t uAge = 0) const;
+		PhaseStats GetStats(Phase ePhase) const;
+		static const char* GetPhaseName(Phase ePhase);
+
+	public: // Reports
+		std::string ShowStats() const;
+		bool DumpCSV(const std::string& sFilePath) const;
+		bool DumpJSON(const std::string& sFilePath) const;
+
+	private:
+		void EndInput();
+		void EndFrame();
+	};
+} // namespace app
+
+#endif // G_PROFILER_H
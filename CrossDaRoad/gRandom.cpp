@@ -0,0 +1,165 @@
+#include "gRandom.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+
+/**
+ * @file gRandom.cpp
+ *
+ * @brief Contains random stream class and random service class implementation
+ *
+ * This file implements the counter-based random number generator. The n-th value of a stream is
+ * SplitMix64(key + n * golden ratio), which is what SplitMix64 produces sequentially, but can be
+ * reached directly by setting the counter.
+**/
+
+namespace app
+{
+	/// @brief Golden ratio increment of SplitMix64
+	static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+	/// @brief SplitMix64 finalizer, a bijective mixing of 64 bits
+	static uint64_t Mix64(uint64_t uValue)
+	{
+		uValue = (uValue ^ (uValue >> 30)) * 0xBF58476D1CE4E5B9ull;
+		uValue = (uValue ^ (uValue >> 27)) * 0x94D049BB133111EBull;
+		return uValue ^ (uValue >> 31);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// RANDOM STREAM //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Parameterized constructor
+	/// @param uKey Key of the stream
+	/// @param uCounter Position in the stream
+	RandomStream::RandomStream(const uint64_t uKey, const uint64_t uCounter)
+	{
+		this->uKey = uKey;
+		this->uCounter = uCounter;
+	}
+
+	/// @brief Draw next 64 random bits (for std distributions)
+	RandomStream::result_type RandomStream::operator()()
+	{
+		return NextU64();
+	}
+	/// @brief Draw next 64 random bits
+	uint64_t RandomStream::NextU64()
+	{
+		return Mix64(uKey + ++uCounter * GOLDEN_GAMMA);
+	}
+	/// @brief Draw next 32 random bits
+	uint32_t RandomStream::NextU32()
+	{
+		return static_cast<uint32_t>(NextU64() >> 32);
+	}
+	/// @brief Draw next float uniformly in [0, 1)
+	float RandomStream::NextFloat()
+	{
+		return static_cast<float>(NextU64() >> 40) * (1.0f / 16777216.0f);
+	}
+	/// @brief Draw next float uniformly in [fLow, fHigh)
+	float RandomStream::Uniform(const float fLow, const float fHigh)
+	{
+		return fLow + (fHigh - fLow) * NextFloat();
+	}
+	/// @brief Draw next integer uniformly in [nLow, nHigh]
+	int RandomStream::UniformInt(const int nLow, const int nHigh)
+	{
+		if (nHigh <= nLow) {
+			return nLow;
+		}
+		const uint64_t uRange = static_cast<uint64_t>(static_cast<int64_t>(nHigh) - nLow) + 1;
+		return static_cast<int>(nLow + static_cast<int64_t>(NextU64() % uRange));
+	}
+	/// @brief Draw next waiting time of a Poisson process
+	/// @param fRate Number of events per unit of time (must be positive)
+	/// @return Exponentially distributed time, +oo if rate is not positive
+	float RandomStream::Exponential(const float fRate)
+	{
+		if (fRate <= 0) {
+			return std::numeric_limits<float>::infinity();
+		}
+		return -std::log1p(-NextFloat()) / fRate;
+	}
+	/// @brief Draw next event with given probability
+	/// @param fProbability Probability in [0, 1]
+	bool RandomStream::Chance(const float fProbability)
+	{
+		return NextFloat() < fProbability;
+	}
+
+	/// @brief Derive an independent stream, without drawing from this one
+	/// @param uStream Identifier of the derived stream (e.g. lane index)
+	RandomStream RandomStream::Split(const uint64_t uStream) const
+	{
+		return RandomStream(Mix64(uKey ^ Mix64(uStream + GOLDEN_GAMMA)));
+	}
+
+	/// @brief Getter for key of the stream
+	uint64_t RandomStream::GetKey() const
+	{
+		return uKey;
+	}
+	/// @brief Getter for number of values drawn from the stream
+	uint64_t RandomStream::GetCounter() const
+	{
+		return uCounter;
+	}
+	/// @brief Jump to a position in the stream
+	/// @param uPosition Number of values considered already drawn
+	void RandomStream::Seek(const uint64_t uPosition)
+	{
+		uCounter = uPosition;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// RANDOM SERVICE /////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor (fresh seed, each run is different)
+	Random::Random()
+	{
+		uSeed = MakeSeed();
+	}
+	/// @brief Parameterized constructor
+	/// @param uSeed Seed of all streams
+	Random::Random(const uint64_t uSeed)
+	{
+		this->uSeed = uSeed;
+	}
+
+	/// @brief Create a fresh seed from hardware entropy and clock
+	uint64_t Random::MakeSeed()
+	{
+		std::random_device device;
+		const uint64_t uEntropy = (static_cast<uint64_t>(device()) << 32) ^ device();
+		const auto uClock = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+		return Mix64(uEntropy ^ Mix64(uClock));
+	}
+	/// @brief Setter for seed (existing streams are not affected)
+	void Random::SetSeed(const uint64_t uSeed)
+	{
+		this->uSeed = uSeed;
+	}
+	/// @brief Getter for seed (to store in saves and replays)
+	uint64_t Random::GetSeed() const
+	{
+		return uSeed;
+	}
+
+	/// @brief Get stream of a gameplay domain
+	/// @param uDomain Identifier of the domain (e.g. summoning)
+	RandomStream Random::GetStream(const uint64_t uDomain) const
+	{
+		return RandomStream(Mix64(uSeed)).Split(uDomain);
+	}
+	/// @brief Get stream of a gameplay domain and index
+	/// @param uDomain Identifier of the domain (e.g. summoning)
+	/// @param uIndex Identifier inside the domain (e.g. map level)
+	RandomStream Random::GetStream(const uint64_t uDomain, const uint64_t uIndex) const
+	{
+		return GetStream(uDomain).Split(uIndex);
+	}
+} // namespace app
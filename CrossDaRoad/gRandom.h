@@ -0,0 +1,77 @@
+#ifndef G_RANDOM_H
+#define G_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @file gRandom.h
+ *
+ * @brief Contains random stream class and random service class
+ *
+ * This file contains a counter-based random number generator. Every number is a pure function of
+ * (key, counter), so streams are cheap to create, to split and to reproduce from a single seed.
+**/
+
+namespace app
+{
+	/// @brief Independent stream of pseudo-random numbers (counter-based, SplitMix64 mixing)
+	class RandomStream
+	{
+	public:
+		using result_type = uint64_t; ///< Result type (UniformRandomBitGenerator)
+
+	private:
+		uint64_t uKey;     ///< Key of the stream (derived from seed and stream identifiers)
+		uint64_t uCounter; ///< Number of values drawn from the stream
+
+	public: // Constructors & Destructor
+		RandomStream(uint64_t uKey = 0, uint64_t uCounter = 0);
+		~RandomStream() = default;
+
+	public: // UniformRandomBitGenerator
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+		result_type operator()();
+
+	public: // Generators
+		uint64_t NextU64();
+		uint32_t NextU32();
+		float NextFloat();
+		float Uniform(float fLow, float fHigh);
+		int UniformInt(int nLow, int nHigh);
+		float Exponential(float fRate);
+		bool Chance(float fProbability);
+
+	public: // Streams
+		RandomStream Split(uint64_t uStream) const;
+
+	public: // Getters & Setters
+		uint64_t GetKey() const;
+		uint64_t GetCounter() const;
+		void Seek(uint64_t uPosition);
+	};
+
+	/// @brief Random service owned by the engine, all gameplay streams derive from its seed
+	class Random
+	{
+	private:
+		uint64_t uSeed; ///< Current seed
+
+	public: // Constructors & Destructor
+		Random();
+		explicit Random(uint64_t uSeed);
+		~Random() = default;
+
+	public: // Seed
+		static uint64_t MakeSeed();
+		void SetSeed(uint64_t uSeed);
+		uint64_t GetSeed() const;
+
+	public: // Streams
+		RandomStream GetStream(uint64_t uDomain) const;
+		RandomStream GetStream(uint64_t uDomain, uint64_t uIndex) const;
+	};
+} // namespace app
+
+#endif // G_RANDOM_H
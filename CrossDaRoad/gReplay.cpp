@@ -0,0 +1,427 @@
+#include "gReplay.h"
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+/**
+ * @file gReplay.cpp
+ *
+ * @brief Contains replay summary struct, replay recorder class and replay player class implementation
+ *
+ * This file implements the replay file. It starts with the magic "CDRP", a version and the header
+ * (little-endian integers), then one record per key change or state hash: a type byte, the number of
+ * keyboard samples since the previous record (LEB128 varint), then the key (1 byte) or the hash (8
+ * bytes). A minute of play at 120 samples per second takes a few kilobytes.
+**/
+
+namespace app
+{
+	static constexpr char REPLAY_MAGIC[4] = { 'C', 'D', 'R', 'P' };
+	static constexpr uint16_t REPLAY_VERSION = 1;
+
+	/// @brief Types of the records of a replay file
+	enum ReplayRecordType : uint8_t
+	{
+		KEY_RELEASE_RECORD = 0, ///< A key was released (followed by the key)
+		KEY_PRESS_RECORD = 1,   ///< A key was pressed (followed by the key)
+		STATE_HASH_RECORD = 2,  ///< Hash of the game state (followed by the hash)
+		END_RECORD = 3,         ///< End of the recording (followed by the final hash)
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// REPLAY SUMMARY ////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Check if the replay reached the end of the recording with the same states
+	bool ReplaySummary::IsIdentical() const
+	{
+		return bComplete && uMismatches == 0;
+	}
+
+	/// @brief Getter for the summary as a string
+	std::string ReplaySummary::Show() const
+	{
+		std::ostringstream output;
+		output << (bReplay ? "[Replay: " : "[Recording: ") << uSamples << " keyboard samples, ";
+		output << uKeyEvents << " key changes, " << uHashes << " state hashes";
+		if (bReplay) {
+			if (!bComplete) {
+				output << ", stopped before the end of the recording";
+			}
+			if (uMismatches > 0) {
+				output << ", " << uMismatches << " differ (first at sample " << uFirstMismatch << ")";
+			}
+			else if (bComplete) {
+				output << ", identical";
+			}
+		}
+		output << "]";
+		return output.str();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////// REPLAY RECORDER ///////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor, nothing is recorded
+	ReplayRecorder::ReplayRecorder()
+	{
+		uLastSample = 0;
+	}
+
+	/// @brief Request a recording of the next session (see Begin)
+	/// @param sReplayFilePath File to record to (empty to cancel the request)
+	/// @param uHashInterval Keyboard samples between two state hashes (0: only the final hash)
+	void ReplayRecorder::Request(const std::string& sReplayFilePath, const uint32_t uHashInterval)
+	{
+		sFilePath = sReplayFilePath;
+		header.uHashInterval = uHashInterval;
+	}
+
+	/// @brief Start the requested recording, at keyboard sample 0
+	/// @param uSeed Seed of the gameplay random streams
+	/// @param nLevel Level the game starts at
+	/// @param fTimeStep Fixed simulation time step in seconds (0: variable)
+	/// @return true if the replay file was opened, false otherwise
+	bool ReplayRecorder::Begin(const uint64_t uSeed, const int32_t nLevel, const float fTimeStep)
+	{
+		if (sFilePath.empty()) {
+			return false;
+		}
+		output.open(sFilePath, std::ios::binary | std::ios::trunc);
+		if (!output.is_open()) {
+			std::cerr << "Failed to open file: " << sFilePath << std::endl;
+			sFilePath.clear();
+			return false;
+		}
+		if (fTimeStep <= 0) {
+			std::cerr << "Warning: recording without fixed time step, the replay may not be reproducible" << std::endl;
+		}
+		header.uSeed = uSeed;
+		header.nLevel = nLevel;
+		header.fTimeStep = fTimeStep;
+		uLastSample = 0;
+		summary = ReplaySummary();
+
+		uint32_t uTimeStepBits = 0;
+		std::memcpy(&uTimeStepBits, &header.fTimeStep, sizeof(uTimeStepBits));
+		output.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+		WriteInteger(REPLAY_VERSION, 2);
+		WriteInteger(header.uSeed, 8);
+		WriteInteger(static_cast<uint32_t>(header.nLevel), 4);
+		WriteInteger(header.uHashInterval, 4);
+		WriteInteger(uTimeStepBits, 4);
+		return true;
+	}
+
+	/// @brief End the recording with the final state hash, and close the replay file
+	/// @param uSample Number of keyboard samples of the session
+	/// @param uStateHash Hash of the game state at the end of the session
+	/// @return true if the replay file was written, false otherwise
+	bool ReplayRecorder::End(const uint64_t uSample, const uint64_t uStateHash)
+	{
+		if (!output.is_open()) {
+			return false;
+		}
+		WriteRecord(END_RECORD, uSample);
+		WriteInteger(uStateHash, 8);
+		summary.uHashes++;
+		summary.uSamples = uSample;
+		const bool bWritten = output.good();
+		output.close();
+		if (!bWritten) {
+			std::cerr << "Failed to write file: " << sFilePath << std::endl;
+		}
+		sFilePath.clear(); // One session per request
+		return bWritten;
+	}
+
+	/// @brief Check if a recording is requested or running
+	bool ReplayRecorder::IsRequested() const
+	{
+		return !sFilePath.empty();
+	}
+
+	/// @brief Check if a recording is running
+	bool ReplayRecorder::IsRecording() const
+	{
+		return output.is_open();
+	}
+
+	/// @brief Check if the game state is hashed at a keyboard sample
+	bool ReplayRecorder::IsHashSample(const uint64_t uSample) const
+	{
+		return output.is_open() && header.uHashInterval > 0 && uSample % header.uHashInterval == 0;
+	}
+
+	/// @brief Getter for the summary of the current or last recording
+	const ReplaySummary& ReplayRecorder::GetSummary() const
+	{
+		return summary;
+	}
+
+	/// @brief Record a key change, applied by the keyboard sample
+	/// @param uSample Keyboard sample of the change
+	/// @param eKey The key that changed
+	/// @param bPressed true if the key was pressed, false if it was released
+	void ReplayRecorder::RecordKey(const uint64_t uSample, const Key eKey, const bool bPressed)
+	{
+		WriteRecord(bPressed ? KEY_PRESS_RECORD : KEY_RELEASE_RECORD, uSample);
+		WriteInteger(static_cast<uint8_t>(eKey), 1);
+		summary.uKeyEvents++;
+	}
+
+	/// @brief Record the hash of the game state at a keyboard sample (after its key changes)
+	/// @param uSample Keyboard sample of the hash
+	/// @param uStateHash Hash of the game state
+	void ReplayRecorder::RecordHash(const uint64_t uSample, const uint64_t uStateHash)
+	{
+		WriteRecord(STATE_HASH_RECORD, uSample);
+		WriteInteger(uStateHash, 8);
+		summary.uHashes++;
+	}
+
+	/// @brief Write the type and the sample delta of a record
+	void ReplayRecorder::WriteRecord(const uint8_t uType, const uint64_t uSample)
+	{
+		output.put(static_cast<char>(uType));
+		WriteVarint(uSample - uLastSample);
+		uLastSample = uSample;
+	}
+
+	/// @brief Write an unsigned integer in LEB128 (7 bits per byte, low bits first)
+	void ReplayRecorder::WriteVarint(uint64_t uValue)
+	{
+		while (uValue >= 0x80) {
+			output.put(static_cast<char>((uValue & 0x7F) | 0x80));
+			uValue >>= 7;
+		}
+		output.put(static_cast<char>(uValue));
+	}
+
+	/// @brief Write the low bytes of an unsigned integer, little-endian
+	void ReplayRecorder::WriteInteger(const uint64_t uValue, const size_t uBytes)
+	{
+		for (size_t uByte = 0; uByte < uBytes; uByte++) {
+			output.put(static_cast<char>((uValue >> (8 * uByte)) & 0xFF));
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////// REPLAY PLAYER ////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Reader of a replay file in memory, failing on truncated data
+	class ReplayReader
+	{
+	private:
+		const std::vector<uint8_t>& data; ///< Content of the file
+		size_t uOffset;                   ///< Next byte to read
+
+	public:
+		explicit ReplayReader(const std::vector<uint8_t>& fileData) : data(fileData), uOffset(0) {}
+
+		/// @brief Check if all bytes were read
+		bool IsEnd() const
+		{
+			return uOffset >= data.size();
+		}
+		/// @brief Read a little-endian unsigned integer of a number of bytes
+		bool ReadInteger(uint64_t& uValue, const size_t uBytes)
+		{
+			if (data.size() - uOffset < uBytes) {
+				return false;
+			}
+			uValue = 0;
+			for (size_t uByte = 0; uByte < uBytes; uByte++) {
+				uValue |= static_cast<uint64_t>(data[uOffset++]) << (8 * uByte);
+			}
+			return true;
+		}
+		/// @brief Read an unsigned LEB128 integer
+		bool ReadVarint(uint64_t& uValue)
+		{
+			uValue = 0;
+			for (int nShift = 0; nShift < 64 && uOffset < data.size(); nShift += 7) {
+				const uint8_t uByte = data[uOffset++];
+				uValue |= static_cast<uint64_t>(uByte & 0x7F) << nShift;
+				if ((uByte & 0x80) == 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/// @brief Default constructor, no replay is loaded
+	ReplayPlayer::ReplayPlayer()
+	{
+		bLoaded = false;
+		uNext = 0;
+		uEndSample = 0;
+		uEndHash = 0;
+		bEndHash = false;
+	}
+
+	/// @brief Load a replay file, played from keyboard sample 0
+	/// @param sReplayFilePath Replay file written by ReplayRecorder
+	/// @return true if the file was loaded (a truncated recording is played up to its last record), false otherwise
+	bool ReplayPlayer::Load(const std::string& sReplayFilePath)
+	{
+		bLoaded = false;
+		std::ifstream fin(sReplayFilePath, std::ios::binary);
+		if (!fin.is_open()) {
+			std::cerr << "Failed to open file: " << sReplayFilePath << std::endl;
+			return false;
+		}
+		const std::vector<uint8_t> data((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+		ReplayReader reader(data);
+
+		uint64_t uMagic = 0, uVersion = 0, uSeed = 0, uLevel = 0, uHashInterval = 0, uTimeStepBits = 0;
+		if (data.size() < sizeof(REPLAY_MAGIC) || std::memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0
+			|| !reader.ReadInteger(uMagic, sizeof(REPLAY_MAGIC)) || !reader.ReadInteger(uVersion, 2)) {
+			std::cerr << sReplayFilePath << ": not a replay file" << std::endl;
+			return false;
+		}
+		if (uVersion != REPLAY_VERSION) {
+			std::cerr << sReplayFilePath << ": unsupported replay version " << uVersion << std::endl;
+			return false;
+		}
+		if (!reader.ReadInteger(uSeed, 8) || !reader.ReadInteger(uLevel, 4)
+			|| !reader.ReadInteger(uHashInterval, 4) || !reader.ReadInteger(uTimeStepBits, 4)) {
+			std::cerr << sReplayFilePath << ": truncated header" << std::endl;
+			return false;
+		}
+		header.uSeed = uSeed;
+		header.nLevel = static_cast<int32_t>(static_cast<uint32_t>(uLevel));
+		header.uHashInterval = static_cast<uint32_t>(uHashInterval);
+		const uint32_t uTimeStep = static_cast<uint32_t>(uTimeStepBits);
+		std::memcpy(&header.fTimeStep, &uTimeStep, sizeof(header.fTimeStep));
+
+		records.clear();
+		bEndHash = false;
+		uint64_t uSample = 0;
+		while (!reader.IsEnd() && !bEndHash) {
+			uint64_t uType = 0, uDelta = 0, uValue = 0;
+			const bool bRead = reader.ReadInteger(uType, 1) && reader.ReadVarint(uDelta)
+				&& reader.ReadInteger(uValue, uType <= KEY_PRESS_RECORD ? 1 : 8);
+			if (!bRead || uType > END_RECORD || (uType <= KEY_PRESS_RECORD && uValue >= KEYBOARD_SIZE)) {
+				std::cerr << sReplayFilePath << ": invalid record after sample " << uSample << std::endl;
+				break;
+			}
+			uSample += uDelta;
+			if (uType == END_RECORD) {
+				uEndSample = uSample;
+				uEndHash = uValue;
+				bEndHash = true;
+			}
+			else {
+				const bool bKey = uType <= KEY_PRESS_RECORD;
+				records.push_back(Record{ uSample, static_cast<uint8_t>(uType), bKey ? static_cast<Key>(uValue) : NONE, bKey ? 0 : uValue });
+			}
+		}
+		if (!bEndHash) { // Recording interrupted (e.g. crash): played up to its last record
+			std::cerr << sReplayFilePath << ": no end record, replaying up to sample " << uSample << std::endl;
+			uEndSample = records.empty() ? 0 : records.back().uSample + 1;
+		}
+		uNext = 0;
+		summary = ReplaySummary();
+		summary.bReplay = true;
+		bLoaded = true;
+		return true;
+	}
+
+	/// @brief End the replay, and compare the final state with the end of the recording
+	/// @param uSample Number of keyboard samples of the replay
+	/// @param uStateHash Hash of the game state at the end of the replay
+	/// @return true if the replay reached the end of the recording with the same states, false otherwise
+	bool ReplayPlayer::Finish(const uint64_t uSample, const uint64_t uStateHash)
+	{
+		if (!bLoaded) {
+			return false;
+		}
+		summary.uSamples = uSample;
+		summary.bComplete = uSample == uEndSample && uNext == records.size();
+		if (summary.bComplete && bEndHash) {
+			Verify(uSample, uStateHash, uEndHash);
+		}
+		bLoaded = false;
+		records.clear();
+		return summary.IsIdentical();
+	}
+
+	/// @brief Check if a replay is loaded and not finished
+	bool ReplayPlayer::IsLoaded() const
+	{
+		return bLoaded;
+	}
+
+	/// @brief Getter for the start conditions of the loaded replay
+	const ReplayHeader& ReplayPlayer::GetHeader() const
+	{
+		return header;
+	}
+
+	/// @brief Check if a keyboard sample is past the end of the recording
+	bool ReplayPlayer::IsEnd(const uint64_t uSample) const
+	{
+		return bLoaded && uSample >= uEndSample;
+	}
+
+	/// @brief Check if the recording has a state hash at a keyboard sample
+	bool ReplayPlayer::IsHashSample(const uint64_t uSample) const
+	{
+		return bLoaded && uNext < records.size() && records[uNext].uSample == uSample
+			&& records[uNext].uType == STATE_HASH_RECORD;
+	}
+
+	/// @brief Getter for the summary of the current or last replay
+	const ReplaySummary& ReplayPlayer::GetSummary() const
+	{
+		return summary;
+	}
+
+	/// @brief Feed the key changes of a keyboard sample to the keyboard, before the sample
+	/// @param uSample Keyboard sample about to be taken
+	/// @param keyboard Keyboard state receiving the changes
+	/// @return The number of applied key changes
+	size_t ReplayPlayer::Apply(const uint64_t uSample, KeyboardState& keyboard)
+	{
+		size_t uApplied = 0;
+		while (bLoaded && uNext < records.size() && records[uNext].uSample <= uSample && records[uNext].uType <= KEY_PRESS_RECORD) {
+			keyboard.SetKey(records[uNext].eKey, records[uNext].uType == KEY_PRESS_RECORD);
+			uNext++;
+			uApplied++;
+		}
+		summary.uKeyEvents += uApplied;
+		return uApplied;
+	}
+
+	/// @brief Compare the game state with the state hash recorded at a keyboard sample (see IsHashSample)
+	/// @param uSample Keyboard sample of the hash
+	/// @param uStateHash Hash of the game state
+	/// @return true if the states are the same, false otherwise
+	bool ReplayPlayer::Verify(const uint64_t uSample, const uint64_t uStateHash)
+	{
+		if (!IsHashSample(uSample)) {
+			return true;
+		}
+		return Verify(uSample, uStateHash, records[uNext++].uHash);
+	}
+
+	/// @brief Compare a state hash with the recorded one, and report the first difference
+	bool ReplayPlayer::Verify(const uint64_t uSample, const uint64_t uStateHash, const uint64_t uRecordedHash)
+	{
+		summary.uHashes++;
+		if (uStateHash == uRecordedHash) {
+			return true;
+		}
+		if (summary.uMismatches++ == 0) {
+			summary.uFirstMismatch = uSample;
+			std::cerr << "Replay diverged at keyboard sample " << uSample << ": state hash " << std::hex << std::setfill('0')
+				<< std::setw(16) << uStateHash << ", recorded " << std::setw(16) << uRecordedHash << std::dec << std::endl;
+		}
+		return false;
+	}
+} // namespace app
@@ -0,0 +1,161 @@
+#ifndef G_REPLAY_H
+#define G_REPLAY_H
+
+#include "gKey.h"
+#include "gState.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file gReplay.h
+ *
+ * @brief Contains state hasher class, replay header struct, replay summary struct, replay recorder class
+ * and replay player class
+ *
+ * This file contains the input replay of the engine. A recording starts with the seed of the gameplay
+ * random streams, the starting level and the simulation time step, then stores each key change with the
+ * keyboard sample it happened at, and a hash of the game state every few samples. Playing it back from
+ * the same seed feeds the same keys at the same samples, so the game reaches the same state, and the
+ * hashes tell the first sample where it did not (a non-deterministic bug, or a build that changed the
+ * game logic).
+**/
+
+namespace app
+{
+	/// @brief 64-bit FNV-1a hash of values, to hash a game state
+	class StateHasher
+	{
+	private:
+		uint64_t uHash = 0xCBF29CE484222325ull; ///< Hash of the values added so far
+
+	public: // Update
+		/// @brief Add the bytes of a trivially copyable value to the hash
+		/// @return The hasher, to chain the values
+		template <class T>
+		StateHasher& Add(const T& value)
+		{
+			unsigned char bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			for (const unsigned char byte : bytes) {
+				uHash = (uHash ^ byte) * 0x100000001B3ull;
+			}
+			return *this;
+		}
+
+	public: // Getters
+		/// @brief Getter for the hash of the values added so far
+		uint64_t Get() const
+		{
+			return uHash;
+		}
+	};
+
+	/// @brief Start conditions of a recording
+	struct ReplayHeader
+	{
+		uint64_t uSeed = 0;         ///< Seed of the gameplay random streams
+		int32_t nLevel = 0;         ///< Level the game started at
+		uint32_t uHashInterval = 0; ///< Keyboard samples between two state hashes
+		float fTimeStep = 0.0f;     ///< Fixed simulation time step in seconds (0: variable, not reproducible)
+	};
+
+	/// @brief Summary of a recording or a replay
+	struct ReplaySummary
+	{
+		uint64_t uSamples = 0;       ///< Number of keyboard samples
+		size_t uKeyEvents = 0;       ///< Number of recorded or replayed key changes
+		size_t uHashes = 0;          ///< Number of recorded or verified state hashes
+		size_t uMismatches = 0;      ///< Number of state hashes that differ from the recording
+		uint64_t uFirstMismatch = 0; ///< Keyboard sample of the first differing state hash
+		bool bComplete = false;      ///< If the replay reached the end of the recording
+		bool bReplay = false;        ///< If this is the summary of a replay (otherwise of a recording)
+
+		bool IsIdentical() const;
+		std::string Show() const;
+	};
+
+	/// @brief Writes the key changes and state hashes of a session to a replay file
+	class ReplayRecorder
+	{
+	private:
+		std::string sFilePath;  ///< File to record to (empty if no recording is requested)
+		std::ofstream output;   ///< Opened replay file
+		ReplayHeader header;    ///< Start conditions of the recording
+		uint64_t uLastSample;   ///< Keyboard sample of the last record (records store the delta)
+		ReplaySummary summary;  ///< Summary of the recording
+
+	public: // Constructors & Destructor
+		ReplayRecorder();
+		~ReplayRecorder() = default;
+
+	public: // Setters
+		void Request(const std::string& sReplayFilePath, uint32_t uHashInterval);
+		bool Begin(uint64_t uSeed, int32_t nLevel, float fTimeStep);
+		bool End(uint64_t uSample, uint64_t uStateHash);
+
+	public: // Getters
+		bool IsRequested() const;
+		bool IsRecording() const;
+		bool IsHashSample(uint64_t uSample) const;
+		const ReplaySummary& GetSummary() const;
+
+	public: // Record
+		void RecordKey(uint64_t uSample, Key eKey, bool bPressed);
+		void RecordHash(uint64_t uSample, uint64_t uStateHash);
+
+	private:
+		void WriteRecord(uint8_t uType, uint64_t uSample);
+		void WriteVarint(uint64_t uValue);
+		void WriteInteger(uint64_t uValue, size_t uBytes);
+	};
+
+	/// @brief Feeds the key changes of a replay file to the keyboard and verifies the state hashes
+	class ReplayPlayer
+	{
+	private:
+		/// @brief Record of a replay file
+		struct Record
+		{
+			uint64_t uSample; ///< Keyboard sample of the record
+			uint8_t uType;    ///< Type of the record (see gReplay.cpp)
+			Key eKey;         ///< Key of a key record
+			uint64_t uHash;   ///< State hash of a hash or end record
+		};
+
+		bool bLoaded;                ///< If a replay is loaded and not finished
+		ReplayHeader header;         ///< Start conditions of the recording
+		std::vector<Record> records; ///< Records of the recording, by sample
+		size_t uNext;                ///< Next record to apply
+		uint64_t uEndSample;         ///< Number of keyboard samples of the recording
+		uint64_t uEndHash;           ///< State hash at the end of the recording
+		bool bEndHash;               ///< If the recording has an end record (it was not interrupted)
+		ReplaySummary summary;       ///< Summary of the replay
+
+	public: // Constructors & Destructor
+		ReplayPlayer();
+		~ReplayPlayer() = default;
+
+	public: // Setters
+		bool Load(const std::string& sReplayFilePath);
+		bool Finish(uint64_t uSample, uint64_t uStateHash);
+
+	public: // Getters
+		bool IsLoaded() const;
+		const ReplayHeader& GetHeader() const;
+		bool IsEnd(uint64_t uSample) const;
+		bool IsHashSample(uint64_t uSample) const;
+		const ReplaySummary& GetSummary() const;
+
+	public: // Replay
+		size_t Apply(uint64_t uSample, KeyboardState& keyboard);
+		bool Verify(uint64_t uSample, uint64_t uStateHash);
+
+	private:
+		bool Verify(uint64_t uSample, uint64_t uStateHash, uint64_t uRecordedHash);
+	};
+} // namespace app
+
+#endif // G_REPLAY_H
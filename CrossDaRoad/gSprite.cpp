@@ -1,7 +1,6 @@
 #include "gSprite.h"
 #include "gUtils.h"
 
-#include <Windows.h>
 #include <algorithm>
 #include <cwchar>
 #include <fstream>
@@ -10,6 +9,9 @@
 #include <string>
 #include <vector>
 
+#ifdef _WIN32
+#include <Windows.h>
+
 // Graphic Interface
 #pragma comment(lib, "gdi32.lib")
 #pragma comment(lib, "gdiplus.lib")
@@ -17,6 +19,10 @@
 
 #undef min
 #undef max
+#else
+// Image files are decoded by libpng outside Windows
+#include <png.h>
+#endif
 
 /**
  * @file gSprite.h
@@ -28,6 +34,7 @@
 
 namespace app
 {
+#ifdef _WIN32
 	/// @brief Static class for GDI+ initialization and conversion from GDI+ color to Pixel color
 	static class GDIP
 	{
@@ -50,6 +57,7 @@ namespace app
 			return { pixelColor.GetRed(), pixelColor.GetGreen(), pixelColor.GetBlue(), pixelColor.GetAlpha() };
 		}
 	} gdistartup;
+#endif
 
 
 	//////////////////////////////////////////////////////////////////////////////////////////
@@ -121,6 +129,7 @@ namespace app
 	/// @return engine::Code engine::SUCCESS if sprite was loaded from file, engine::FAILURE otherwise
 	engine::Code Sprite::LoadFromFile(const std::string& imageFilePath, app::ResourcePack* pack)
 	{
+#ifdef _WIN32
 		Gdiplus::Bitmap* bitmap = Gdiplus::Bitmap::FromFile(to_text(imageFilePath));
 		if (bitmap == nullptr) {
 			return engine::FILE_NOT_FOUND;
@@ -149,6 +158,38 @@ namespace app
 
 		delete bitmap;
 		return engine::SUCCESS;
+#else
+		png_image image{};
+		image.version = PNG_IMAGE_VERSION;
+		if (!png_image_begin_read_from_file(&image, imageFilePath.c_str())) {
+			return engine::FILE_NOT_FOUND;
+		}
+
+		width = static_cast<int32_t>(image.width);
+		if (width <= 0) {
+			png_image_free(&image);
+			return engine::INVALID_WIDTH;
+		}
+
+		height = static_cast<int32_t>(image.height);
+		if (height <= 0) {
+			png_image_free(&image);
+			return engine::INVALID_HEIGHT;
+		}
+
+		// Pixel is laid out as 8-bit r, g, b, a (the same layout as the OpenGL texture)
+		image.format = PNG_FORMAT_RGBA;
+		pColData = new Pixel[width * height];
+		if (!png_image_finish_read(&image, nullptr, pColData, 0, nullptr)) {
+			std::cerr << "Can not decode image (" << imageFilePath << "): " << image.message << std::endl;
+			delete[] pColData;
+			pColData = nullptr;
+			width = 0;
+			height = 0;
+			return engine::FILE_READ_ERROR;
+		}
+		return engine::SUCCESS;
+#endif
 	}
 
 	/// @brief Reads the pixel data from the specified input stream into the sprite object
@@ -0,0 +1,146 @@
+#include "gSpriteMask.h"
+#include <algorithm>
+
+/**
+ * @file gSpriteMask.cpp
+ *
+ * @brief Contains sprite mask class implementation
+ *
+ * This file implements sprite mask class. A pixel is opaque when it would be drawn in Pixel::MASK mode
+ * (alpha = 255).
+**/
+
+namespace app
+{
+	////////////////////////////////////////////////////////////////////////////
+	/////////////////////// CONSTRUCTORS & DESTRUCTOR //////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Default constructor (empty mask)
+	SpriteMask::SpriteMask()
+	{
+		nWidth = 0;
+		nHeight = 0;
+		arrRows.fill(0);
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////// BUILDERS //////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Build a fully opaque mask
+	/// @param nWidth Width of the mask (clamped to MAX_SIZE)
+	/// @param nHeight Height of the mask (clamped to MAX_SIZE)
+	SpriteMask SpriteMask::Full(const int32_t nWidth, const int32_t nHeight)
+	{
+		SpriteMask mask;
+		mask.nWidth = std::clamp(nWidth, 0, MAX_SIZE);
+		mask.nHeight = std::clamp(nHeight, 0, MAX_SIZE);
+		const uint32_t uRow = mask.nWidth == MAX_SIZE ? ~0u : (1u << mask.nWidth) - 1;
+		std::fill_n(mask.arrRows.begin(), mask.nHeight, uRow);
+		return mask;
+	}
+	/// @brief Build the mask of a sprite region
+	/// @param pSprite Sprite to read (nullptr gives an empty mask)
+	/// @param nOriginX X-coordinate of the region in the sprite
+	/// @param nOriginY Y-coordinate of the region in the sprite
+	/// @param nWidth Width of the region (clamped to MAX_SIZE)
+	/// @param nHeight Height of the region (clamped to MAX_SIZE)
+	SpriteMask SpriteMask::FromSprite(const Sprite* pSprite, const int32_t nOriginX, const int32_t nOriginY, const int32_t nWidth, const int32_t nHeight)
+	{
+		SpriteMask mask;
+		mask.nWidth = std::clamp(nWidth, 0, MAX_SIZE);
+		mask.nHeight = std::clamp(nHeight, 0, MAX_SIZE);
+		if (pSprite == nullptr) {
+			return mask;
+		}
+		for (int32_t y = 0; y < mask.nHeight; y++) {
+			uint32_t uRow = 0;
+			for (int32_t x = 0; x < mask.nWidth; x++) {
+				const int32_t nSpriteX = nOriginX + x;
+				const int32_t nSpriteY = nOriginY + y;
+				if (pSprite->Inside(nSpriteX, nSpriteY) && pSprite->GetPixel(nSpriteX, nSpriteY).a == 255) {
+					uRow |= 1u << x;
+				}
+			}
+			mask.arrRows[y] = uRow;
+		}
+		return mask;
+	}
+	/// @brief Build the mask of a whole sprite
+	/// @param pSprite Sprite to read (nullptr gives an empty mask)
+	SpriteMask SpriteMask::FromSprite(const Sprite* pSprite)
+	{
+		if (pSprite == nullptr) {
+			return SpriteMask();
+		}
+		return FromSprite(pSprite, 0, 0, pSprite->Width(), pSprite->Height());
+	}
+	/// @brief Merge the opaque pixels of another mask into this mask
+	SpriteMask& SpriteMask::operator|=(const SpriteMask& other)
+	{
+		nWidth = std::max(nWidth, other.nWidth);
+		nHeight = std::max(nHeight, other.nHeight);
+		for (int32_t y = 0; y < MAX_SIZE; y++) {
+			arrRows[y] |= other.arrRows[y];
+		}
+		return *this;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////// GETTERS ///////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Getter for width of the mask
+	int32_t SpriteMask::Width() const
+	{
+		return nWidth;
+	}
+	/// @brief Getter for height of the mask
+	int32_t SpriteMask::Height() const
+	{
+		return nHeight;
+	}
+	/// @brief Getter for a row of the mask
+	/// @param y Row index
+	/// @return Bits of the row (bit x set if pixel x is opaque), 0 if y is outside the mask
+	uint32_t SpriteMask::GetRow(const int32_t y) const
+	{
+		return (0 <= y && y < nHeight) ? arrRows[y] : 0;
+	}
+	/// @brief Check if the mask has no opaque pixel
+	bool SpriteMask::IsEmpty() const
+	{
+		return std::all_of(arrRows.begin(), arrRows.begin() + nHeight, [](const uint32_t uRow) { return uRow == 0; });
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////// CHECKERS //////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Check if two placed masks share an opaque pixel
+	/// @param nPosX X-coordinate of this mask
+	/// @param nPosY Y-coordinate of this mask
+	/// @param other Other mask
+	/// @param nOtherX X-coordinate of the other mask
+	/// @param nOtherY Y-coordinate of the other mask
+	/// @return true if at least one pixel is opaque in both masks, false otherwise
+	bool SpriteMask::Overlaps(const int32_t nPosX, const int32_t nPosY, const SpriteMask& other, const int32_t nOtherX, const int32_t nOtherY) const
+	{
+		const int32_t nShift = nOtherX - nPosX;
+		if (nShift >= nWidth || -nShift >= other.nWidth) {
+			return false;
+		}
+		const int32_t nTop = std::max(nPosY, nOtherY);
+		const int32_t nBottom = std::min(nPosY + nHeight, nOtherY + other.nHeight);
+		for (int32_t y = nTop; y < nBottom; y++) {
+			const uint64_t uRow = arrRows[y - nPosY];
+			const uint64_t uOtherRow = other.arrRows[y - nOtherY];
+			const uint64_t uPlaced = nShift >= 0 ? (uOtherRow << nShift) : (uOtherRow >> -nShift);
+			if (uRow & uPlaced) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,51 @@
+#ifndef G_SPRITE_MASK_H
+#define G_SPRITE_MASK_H
+
+#include "gSprite.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @file gSpriteMask.h
+ *
+ * @brief Contains sprite mask class
+ *
+ * This file contains a 1-bit-per-pixel opacity mask of a sprite region, one word per row, so that two
+ * masks are tested for overlap with one shift and one AND per overlapping row.
+**/
+
+namespace app
+{
+	/// @brief Opacity mask of a sprite region (at most 32 x 32 pixels)
+	class SpriteMask
+	{
+	public:
+		static constexpr int32_t MAX_SIZE = 32; ///< Maximum width and height of a mask
+
+	private:
+		int32_t nWidth;  ///< Width of the mask
+		int32_t nHeight; ///< Height of the mask
+		std::array<uint32_t, MAX_SIZE> arrRows; ///< Bit x of row y is set if pixel (x, y) is opaque
+
+	public: // Constructors & Destructor
+		SpriteMask();
+		~SpriteMask() = default;
+
+	public: // Builders
+		static SpriteMask Full(int32_t nWidth, int32_t nHeight);
+		static SpriteMask FromSprite(const Sprite* pSprite, int32_t nOriginX, int32_t nOriginY, int32_t nWidth, int32_t nHeight);
+		static SpriteMask FromSprite(const Sprite* pSprite);
+		SpriteMask& operator|=(const SpriteMask& other);
+
+	public: // Getters
+		int32_t Width() const;
+		int32_t Height() const;
+		uint32_t GetRow(int32_t y) const;
+		bool IsEmpty() const;
+
+	public: // Checkers
+		bool Overlaps(int32_t nPosX, int32_t nPosY, const SpriteMask& other, int32_t nOtherX, int32_t nOtherY) const;
+	};
+}
+
+#endif // G_SPRITE_MASK_H
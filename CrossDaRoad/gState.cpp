@@ -1,4 +1,6 @@
 #include "gState.h"
+#include <algorithm>
+#include <cmath>
 
 /**
  * @file gState.cpp
@@ -297,6 +299,7 @@ void FrameState::CreateTimer(const float fTimer, const float fRewind, const int
 void FrameState::ResetTimer()
 {
 	frameTimer = std::chrono::system_clock::now();
+	pacer.Reset();
 }
 
 /// @brief Update the frame 
@@ -333,30 +336,26 @@ bool FrameState::Rewind(float fRewind)
 	fRewindTime += fRewind;
 	return true;
 }
-/// @brief Wait microseconds for the frame timer to be stable before continuing
-/// @param nWait The time to wait
-void FrameState::WaitMicroseconds(const int32_t& nWait) const
+/// @brief Wait for the next frame deadline (sleep, then spin the last slack)
+/// @return true if the frame was on time, false if it was already late
+bool FrameState::WaitNextFrame()
 {
-	if (nWait <= 0) {
-		return;
-	}
-	const auto start = std::chrono::high_resolution_clock::now();
-	while (true) {
-		auto now = std::chrono::high_resolution_clock::now();
-		auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - start);
-		if (microseconds.count() >= nWait) {
-			break;
-		}
-	}
+	return pacer.WaitNextFrame(static_cast<int32_t>(eFrameDelay));
 }
-/// @brief Wait microseconds for the frame timer to be stable before continuing
-/// @param nWait The time to wait
-void FrameState::WaitMicroseconds(const int32_t& nWait, const float& fPassedTime) const
+/// @brief Pace the next frames from now (after a pause, so the pause is not counted as a late frame)
+void FrameState::RestartPacing()
 {
-	if (nWait <= static_cast<int32_t>(fPassedTime)) {
-		return;
-	}
-	return WaitMicroseconds(nWait - static_cast<int32_t>(fPassedTime));
+	pacer.Reset();
+}
+/// @brief Getter for the frame timing statistics of the pacer
+app::FrameJitter FrameState::GetJitter() const
+{
+	return pacer.GetJitter();
+}
+/// @brief Reset the frame timing statistics of the pacer
+void FrameState::ResetJitter()
+{
+	pacer.ResetJitter();
 }
 /// @brief Getter for tick time 
 float FrameState::GetTickTime() const
@@ -381,6 +380,97 @@ float FrameState::GetElapsedTime(const bool bUpdate)
 	return fElapsedTime;
 }
 
+//====================================================================================
+/// @brief Parameterized constructor
+/// @param fStep Duration of one simulation step in seconds (0: variable step)
+SimulationState::SimulationState(const float fStep)
+{
+	fTimeStep = 0;
+	SetTimeStep(fStep);
+	Reset();
+}
+
+/// @brief Setter for the simulation step, the accumulated time is kept
+/// @param fStep Duration of one simulation step in seconds (0: variable step)
+/// @return true if the step is valid, false otherwise
+bool SimulationState::SetTimeStep(const float fStep)
+{
+	if (fStep < 0) {
+		return false;
+	}
+	fTimeStep = fStep;
+	return true;
+}
+
+/// @brief Reset the simulation clock
+void SimulationState::Reset()
+{
+	fAccumulator = 0;
+	fTime = 0;
+	nDroppedSteps = 0;
+}
+
+/// @brief Check if the simulation runs at a fixed rate
+bool SimulationState::IsFixed() const
+{
+	return fTimeStep > 0;
+}
+
+/// @brief Getter for the duration of one simulation step
+float SimulationState::GetTimeStep() const
+{
+	return fTimeStep;
+}
+
+/// @brief Getter for the simulation time
+float SimulationState::GetTime() const
+{
+	return static_cast<float>(fTime);
+}
+
+/// @brief Getter for the interpolation factor between the last two simulation states
+/// @return Fraction of the next step already elapsed, in [0, 1] (1 for variable step)
+float SimulationState::GetAlpha() const
+{
+	if (!IsFixed()) {
+		return 1.0f;
+	}
+	return std::min(fAccumulator / fTimeStep, 1.0f);
+}
+
+/// @brief Getter for the number of steps dropped after stalls
+int SimulationState::GetDroppedSteps() const
+{
+	return nDroppedSteps;
+}
+
+/// @brief Accumulate elapsed time
+/// @param fElapsedTime Elapsed time since the last frame in seconds
+/// @return Number of simulation steps to run this frame
+int SimulationState::Accumulate(const float fElapsedTime)
+{
+	if (!IsFixed()) {
+		return 1;
+	}
+	fAccumulator += std::max(fElapsedTime, 0.0f);
+	int nSteps = static_cast<int>(fAccumulator / fTimeStep);
+	if (nSteps > MAX_STEPS_PER_FRAME) { // Do not spiral after a stall, drop the time instead
+		nDroppedSteps += nSteps - MAX_STEPS_PER_FRAME;
+		fAccumulator -= static_cast<float>(nSteps - MAX_STEPS_PER_FRAME) * fTimeStep;
+		nSteps = MAX_STEPS_PER_FRAME;
+	}
+	return nSteps;
+}
+
+/// @brief Consume one simulation step of the accumulated time
+void SimulationState::Step()
+{
+	if (IsFixed()) {
+		fAccumulator = std::max(fAccumulator - fTimeStep, 0.0f);
+		fTime += fTimeStep;
+	}
+}
+
 //====================================================================================
 /// @brief Default constructor
 KeyboardState::KeyboardState()
@@ -391,13 +481,11 @@ KeyboardState::KeyboardState()
 /// @brief Destructor
 KeyboardState::~KeyboardState()
 {
-	mapKeys.clear();
 }
 
 /// @brief Setter to reset the keyboard state object
 void KeyboardState::ResetKeyboard()
 {
-	mapKeys = app::CreateMapKey();
 	bHasInputFocus = false;
 	memset(bKeysCache, false, sizeof(bKeysCache));
 	memset(bKeys, false, sizeof(bKeys));
@@ -418,6 +506,24 @@ bool KeyboardState::IsFocused() const
 	return bHasInputFocus;
 }
 
+/// @brief Set the state of a key by its game key (e.g. scripted input), applied at the next update
+/// @param key The key to set
+/// @param bValue Value to set (true: pressed, false: released)
+void KeyboardState::SetKey(const app::Key& key, const bool bValue)
+{
+	bKeysCache[key] = bValue;
+}
+
+/// @brief Check if a key changes at the next update (e.g. to record the input)
+/// @param key The key to check
+/// @param bValue Receives the value after the update (true: pressed, false: released)
+/// @return true if the key changes at the next update, false otherwise
+bool KeyboardState::GetKeyChange(const app::Key& key, bool& bValue) const
+{
+	bValue = bKeysCache[key];
+	return bKeysCache[key] != bKeys[key];
+}
+
 /// @brief Update the keyboard state object
 void KeyboardState::UpdateKeyboard()
 {
@@ -2,6 +2,7 @@
 #define G_STATE_H
 
 #include "gKey.h"
+#include "gFramePacer.h"
 #include <cstring>
 #include <cstdint>
 #include <iostream>
@@ -210,6 +211,7 @@ private:
 	FrameDelay eFrameDelay;                                             ///< The frame delay. (default: STABLE_FPS_DELAY)
 	float fRewindTime;
 	float fRewindTemp;
+	app::FramePacer pacer;                                              ///< The pacer waiting for the frame deadlines.
 
 public: // Constructor
 	FrameState(float fTimer = 0, float fRewind = 0, int nFrame = 0, int nFPS = 0);
@@ -229,11 +231,48 @@ public: // Getters
 public: // Update & Wait methods
 	bool FrameUpdate(float fElapsedTime);
 	bool Rewind(float fRewind);
-	void WaitMicroseconds(const int32_t& nWait) const;
-	void WaitMicroseconds(const int32_t& nWait, const float& fPassedTime) const;
+	bool WaitNextFrame();
+	void RestartPacing();
+	app::FrameJitter GetJitter() const;
+	void ResetJitter();
 };
 #endif // FRAME_STATE
 
+#define SIMULATION_STATE
+#ifdef SIMULATION_STATE
+
+/// @brief Class for storing the state of the fixed-rate simulation clock (accumulator of elapsed time).
+class SimulationState
+{
+public:
+	static constexpr int MAX_STEPS_PER_FRAME = 8; ///< Steps dropped beyond this count (after a stall)
+
+private:
+	float fTimeStep;    ///< Duration of one simulation step in seconds (0: variable step, disabled)
+	float fAccumulator; ///< Elapsed time not yet simulated
+	double fTime;       ///< Simulation time (sum of all simulated steps, double to avoid drift)
+	int nDroppedSteps;  ///< Number of steps dropped to catch up after stalls
+
+public: // Constructor
+	SimulationState(float fStep = 0);
+
+public: // Setters
+	bool SetTimeStep(float fStep);
+	void Reset();
+
+public: // Getters
+	bool IsFixed() const;
+	float GetTimeStep() const;
+	float GetTime() const;
+	float GetAlpha() const;
+	int GetDroppedSteps() const;
+
+public: // Update methods
+	int Accumulate(float fElapsedTime);
+	void Step();
+};
+#endif // SIMULATION_STATE
+
 #define KEYBOARD_STATE
 #ifdef KEYBOARD_STATE
 constexpr size_t KEYBOARD_SIZE = 256;
@@ -246,7 +285,6 @@ private:
 	bool bKeys[KEYBOARD_SIZE];             ///< The current state of the keyboard.
 	bool bKeysCache[KEYBOARD_SIZE];        ///< The cached state of the keyboard.
 	ButtonState pKeysState[KEYBOARD_SIZE]; ///< The state of the keyboard.
-	std::map<uint16_t, uint8_t> mapKeys;   ///< The map of the keyboard.
 
 public: // Constructors & Destructor
 	KeyboardState();
@@ -273,9 +311,10 @@ public: // Update methods
 	template <class Integer>
 	void UpdateKey(const Integer& nID, const bool bValue)
 	{
-		const uint16_t keyID = static_cast<uint16_t>(nID);
-		bKeysCache[mapKeys[keyID]] = bValue;
+		bKeysCache[app::TranslateKeyCode(static_cast<uint16_t>(nID))] = bValue;
 	}
+	void SetKey(const app::Key& key, bool bValue);
+	bool GetKeyChange(const app::Key& key, bool& bValue) const;
 	void UpdateKeyboard();
 };
 #endif // KEYBOARD_STATE
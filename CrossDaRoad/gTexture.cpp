@@ -21,7 +21,7 @@ namespace app
 	}
 	/// @brief Parameterized constructor
 	/// @param windowHandler The window handler for the window to draw on
-	Texture::Texture(const HWND windowHandler)
+	Texture::Texture(const WindowHandle windowHandler)
 	{
 		InitDevice();
 		CreateDeviceContext(windowHandler);
@@ -39,15 +39,19 @@ namespace app
 		pDrawTarget = nullptr;
 		nPixelMode = Pixel::NORMAL;
 		fBlendFactor = 1.0f;
+		ResetDrawStats();
+#ifdef _WIN32
 		glDeviceContext = nullptr;
 		glRenderContext = nullptr;
 		glBuffer = 0;
+#endif
 		return true;
 	}
+#ifdef _WIN32
 	/// @brief Create the device context for the window to draw on
 	/// @param windowHandler  The window handler for the window to draw on
 	/// @return True if the device context was created successfully, false otherwise
-	bool Texture::CreateDeviceContext(const HWND windowHandler)
+	bool Texture::CreateDeviceContext(const WindowHandle windowHandler)
 	{
 		glDeviceContext = GetDC(windowHandler);
 		return glDeviceContext != nullptr;
@@ -299,8 +303,16 @@ namespace app
 	bool Texture::RenderTexture(const int width, const int height, const ViewportState viewport) const
 	{
 		// Retrieve pixel data from the default draw target
-		const Pixel* target = pDefaultDrawTarget->GetData();
-
+		return RenderTexture(width, height, viewport, pDefaultDrawTarget->GetData());
+	}
+	/// @brief Render a frame (e.g. published by another thread) on the screen
+	/// @param width Width of the frame
+	/// @param height Height of the frame
+	/// @param viewport Viewport state
+	/// @param target Pixel data of the frame
+	/// @return Always returns true by default
+	bool Texture::RenderTexture(const int width, const int height, const ViewportState viewport, const Pixel* target) const
+	{
 		// Set the viewport for rendering based on the specified viewport state
 		SetViewport(viewport);
 
@@ -315,6 +327,63 @@ namespace app
 
 		return true;
 	}
+#else
+	///////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////// NO SCREEN (NOT WINDOWS) ////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief No OpenGL device context outside Windows, frames are only drawn (headless runs)
+	/// @return Always false
+	bool Texture::CreateDeviceContext(const WindowHandle windowHandler)
+	{
+		std::cerr << "Error: No OpenGL device context on this platform" << std::endl;
+		return false;
+	}
+	/// @brief Nothing to release without device context
+	/// @return Always returns true by default
+	bool Texture::ExitDevice() const
+	{
+		return true;
+	}
+	// Setup and updater functions have nothing to set up or present
+	bool Texture::SetupFormatter() const
+	{
+		return false;
+	}
+	bool Texture::SetupRendering(const ViewportState viewport)
+	{
+		return false;
+	}
+	bool Texture::SetupTexturing()
+	{
+		return false;
+	}
+	bool Texture::SetupEnvironment(const int width, const int height) const
+	{
+		return false;
+	}
+	bool Texture::CreateTexture2D(const int width, const int height, const ViewportState viewport)
+	{
+		return false;
+	}
+	void Texture::SetViewport(const ViewportState viewport) const
+	{
+	}
+	void Texture::UpdateTexture(const int width, const int height, const Pixel* data) const
+	{
+	}
+	void Texture::DrawTextureOnScreen() const
+	{
+	}
+	bool Texture::RenderTexture(const int width, const int height, const ViewportState viewport) const
+	{
+		return false;
+	}
+	bool Texture::RenderTexture(const int width, const int height, const ViewportState viewport, const Pixel* target) const
+	{
+		return false;
+	}
+#endif
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////////// DRAWING GETTERS //////////////////////////////////////
@@ -365,6 +434,16 @@ namespace app
 	{
 		return nPixelMode;
 	}
+	/// @brief Getter for the number of sprite blits and clears since the last reset.
+	uint32_t Texture::GetDrawCalls() const
+	{
+		return uDrawCalls;
+	}
+	/// @brief Getter for the number of pixels written since the last reset.
+	uint64_t Texture::GetDrawnPixels() const
+	{
+		return uDrawnPixels;
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////////// DRAWING SETTERS //////////////////////////////////////
@@ -405,6 +484,12 @@ namespace app
 		pDefaultDrawTarget = new Sprite(width, height);
 		return true;
 	}
+	/// @brief Reset the draw call and pixel counters (once per presented frame).
+	void Texture::ResetDrawStats()
+	{
+		uDrawCalls = 0;
+		uDrawnPixels = 0;
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////////
 	//////////////////////////// DRAWING FUNCTIONS ////////////////////////////////////////
@@ -443,6 +528,7 @@ namespace app
 			return success;
 		}
 
+		uDrawnPixels++;
 		if (nPixelMode == Pixel::NORMAL) {
 			return pDrawTarget->SetPixel(x, y, current_pixel);
 		}
@@ -477,6 +563,7 @@ namespace app
 		if (pSprite == nullptr || uScale == 0) {
 			return;
 		}
+		uDrawCalls++;
 		for (int32_t nSpriteX = 0; nSpriteX < pSprite->Width(); nSpriteX++) {
 			for (int32_t nSpriteY = 0; nSpriteY < pSprite->Height(); nSpriteY++) {
 				const Pixel pixel = pSprite->GetPixel(nSpriteX, nSpriteY);
@@ -500,6 +587,7 @@ namespace app
 		if (pSprite == nullptr || uScale == 0) {
 			return;
 		}
+		uDrawCalls++;
 		for (int32_t nPartialX = 0; nPartialX < nWidth; nPartialX++) {
 			for (int32_t nPartialY = 0; nPartialY < nHeight; nPartialY++) {
 				const int nPosX = nOffsetX + (nPartialX * uScale);
@@ -516,6 +604,8 @@ namespace app
 		const int size = GetDrawTargetSize();
 		Pixel* targets = GetDrawTarget()->GetData();
 		std::fill_n(targets, size, pixel);
+		uDrawCalls++;
+		uDrawnPixels += size;
 	}
 } // namespace app
 
@@ -1,33 +1,40 @@
 #ifndef G_TEXTURE_H
 #define G_TEXTURE_H
 
-#pragma comment(lib, "opengl32.lib")
-#include <Windows.h>
-#include <GL/gl.h>
 #include "gPixel.h"
+#include "gPlatform.h"
 #include "gState.h"
 #include "gSprite.h"
+#ifdef _WIN32
+#pragma comment(lib, "opengl32.lib")
+#include <GL/gl.h>
+#endif
 
 /**
  * @file gTexture.h
  *
  * @brief Contains texture class
  *
- * This file contains texture class for drawing textures on screen using OpenGL.
+ * This file contains texture class for drawing textures on screen using OpenGL. Drawing on the sprites
+ * works on every platform, presenting them on screen needs Windows (see gPlatform.h).
  */
 
 namespace app
 {
+#ifdef _WIN32
 	/// @brief OpenGL function pointers for dynamic linking
 	typedef BOOL(WINAPI wglSwapInterval_t)(int interval);
 	static wglSwapInterval_t* wglSwapInterval;
+#endif
 	/// @brief Class for drawing textures on screen using OpenGL
 	class Texture
 	{
+#ifdef _WIN32
 	private: // OpenGL Environment variables
 		HDC glDeviceContext;   ///< Device context for OpenGL rendering context
 		HGLRC glRenderContext; ///< Rendering context for OpenGL
 		GLuint glBuffer;       ///< OpenGL buffer for texture
+#endif
 
 	private: // Drawing variables
 		Sprite* pDefaultDrawTarget; ///< Default draw target for drawing on screen (window) using OpenGL functions
@@ -35,12 +42,16 @@ namespace app
 		Pixel::Mode nPixelMode;     ///< Pixel mode for drawing on screen (window) using OpenGL functions
 		float fBlendFactor;         ///< Blend factor for drawing on screen (window) using OpenGL functions
 
+	private: // Drawing statistics
+		mutable uint32_t uDrawCalls;   ///< Sprite blits and clears since the last reset
+		mutable uint64_t uDrawnPixels; ///< Pixels written since the last reset
+
 	public: // Constructors & Destructors
 		Texture();
-		Texture(HWND windowHandler);
+		Texture(WindowHandle windowHandler);
 		~Texture();
 		bool InitDevice();
-		bool CreateDeviceContext(HWND windowHandler);
+		bool CreateDeviceContext(WindowHandle windowHandler);
 		bool ExitDevice() const;
 
 	public: // Setup enviroment
@@ -55,6 +66,7 @@ namespace app
 		void UpdateTexture(int width, int height, const Pixel* data) const;
 		void DrawTextureOnScreen() const;
 		bool RenderTexture(int width, int height, ViewportState viewport) const;
+		bool RenderTexture(int width, int height, ViewportState viewport, const Pixel* data) const;
 
 	public: // Drawing Getters
 		Sprite* GetDrawTarget() const;
@@ -64,12 +76,15 @@ namespace app
 		int32_t GetDrawTargetSize() const;
 		float GetBlendFactor() const;
 		Pixel::Mode GetPixelMode() const;
+		uint32_t GetDrawCalls() const;
+		uint64_t GetDrawnPixels() const;
 
 	public: // Drawing Setters
 		void SetDrawTarget(Sprite* target);
 		void SetPixelMode(Pixel::Mode m);
 		void SetBlendFactor(float fBlend);
 		bool SetDefaultDrawTarget(int32_t width, int32_t height);
+		void ResetDrawStats();
 
 	public: // Drawing functions
 		bool Draw(int32_t x, int32_t y, Pixel current_pixel = app::WHITE, uint32_t uScale = 1);
@@ -0,0 +1,233 @@
+#include "gTrace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @file gTrace.cpp
+ *
+ * @brief Contains trace zone class and trace session functions implementation
+ *
+ * This file implements the trace sessions. Each thread owns a buffer, registered once in a lock-free
+ * list and handed over to a later thread when its owner exits. Only the owner writes its buffer: an
+ * event is stored first and the event count is published after it, so the exporter can read any
+ * buffer at any time and always sees complete events. Buffers drop their events lazily: a buffer
+ * still holding an older session is cleared by its owner on its next record.
+**/
+
+namespace app_trace
+{
+	/// @brief Event buffer of a thread
+	struct ThreadBuffer
+	{
+		std::unique_ptr<Event[]> pEvents;        ///< Recorded zones (allocated on the first record)
+		std::atomic<size_t> uCount{ 0 };         ///< Number of recorded zones, published after each event
+		std::atomic<uint32_t> uSession{ 0 };     ///< Session of the recorded zones
+		std::atomic<const char*> sName{ nullptr }; ///< Name of the owner thread
+		std::atomic<bool> bOwned{ true };        ///< If a running thread owns the buffer
+		uint32_t uThreadId = 0;                  ///< Thread identifier in the exported traces
+		ThreadBuffer* pNext = nullptr;           ///< Next buffer of the registry
+	};
+
+	/// @brief Release the buffer of a thread when the thread exits
+	struct BufferOwner
+	{
+		ThreadBuffer* pBuffer = nullptr; ///< Buffer owned by the thread
+		~BufferOwner()
+		{
+			if (pBuffer) { // The name is kept so that the events of the thread still export under it
+				pBuffer->bOwned.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	static std::atomic<bool> bRecording{ false };         ///< If zones are recorded
+	static std::atomic<uint32_t> uCurrentSession{ 0 };    ///< Current session (0: none started yet)
+	static std::atomic<int64_t> nSessionStart{ 0 };       ///< Time the current session started
+	static std::atomic<ThreadBuffer*> pRegistry{ nullptr }; ///< All buffers ever created (never freed)
+	static std::atomic<uint32_t> uThreadCount{ 0 };       ///< Number of buffers ever created
+	static thread_local BufferOwner bufferOwner;          ///< Buffer of the calling thread
+
+	/// @brief Getter for the buffer of the calling thread, reuse a released buffer or register a new one
+	static ThreadBuffer& GetThreadBuffer()
+	{
+		if (bufferOwner.pBuffer) {
+			return *bufferOwner.pBuffer;
+		}
+		for (ThreadBuffer* pBuffer = pRegistry.load(std::memory_order_acquire); pBuffer; pBuffer = pBuffer->pNext) {
+			bool bOwned = false;
+			if (pBuffer->bOwned.compare_exchange_strong(bOwned, true, std::memory_order_acquire)) {
+				pBuffer->sName.store(nullptr, std::memory_order_relaxed);
+				bufferOwner.pBuffer = pBuffer;
+				return *pBuffer;
+			}
+		}
+		ThreadBuffer* pBuffer = new ThreadBuffer;
+		pBuffer->uThreadId = uThreadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		pBuffer->pNext = pRegistry.load(std::memory_order_relaxed);
+		while (!pRegistry.compare_exchange_weak(pBuffer->pNext, pBuffer, std::memory_order_release, std::memory_order_relaxed)) {
+			// Another thread registered its buffer first, retry on the new head
+		}
+		bufferOwner.pBuffer = pBuffer;
+		return *pBuffer;
+	}
+
+	/// @brief Write a string as a JSON string literal
+	static void WriteString(std::ostream& output, const char* sText)
+	{
+		output << '"';
+		for (const char* pChar = sText ? sText : ""; *pChar; pChar++) {
+			if (*pChar == '"' || *pChar == '\\') {
+				output << '\\';
+			}
+			output << *pChar;
+		}
+		output << '"';
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////// ZONE ///////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Enter a zone
+	/// @param sZoneName Name of the zone (must outlive the session, e.g. a string literal)
+	Zone::Zone(const char* sZoneName)
+	{
+		sName = sZoneName;
+		nBegin = IsRecording() ? GetTimestamp() : -1;
+	}
+
+	/// @brief Leave the zone, record it if a session was recording when it was entered
+	Zone::~Zone()
+	{
+		if (nBegin >= 0) {
+			Record(sName, nBegin, GetTimestamp());
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////// SESSION //////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Start a new session, the zones of the previous one are dropped
+	void Start()
+	{
+		nSessionStart.store(GetTimestamp(), std::memory_order_relaxed);
+		uCurrentSession.fetch_add(1, std::memory_order_acq_rel);
+		bRecording.store(true, std::memory_order_release);
+	}
+
+	/// @brief Stop recording, the session is kept until the next start
+	void Stop()
+	{
+		bRecording.store(false, std::memory_order_release);
+	}
+
+	/// @brief Check if zones are being recorded
+	bool IsRecording()
+	{
+		return bRecording.load(std::memory_order_relaxed);
+	}
+
+	/// @brief Write the current session as Chrome trace-event JSON (one complete event per zone)
+	/// @param sFilePath Path of the JSON file
+	/// @return true if the file was written, false otherwise
+	bool Export(const std::string& sFilePath)
+	{
+		std::ofstream fout(sFilePath);
+		if (!fout.is_open()) {
+			std::cerr << "Failed to open file: " << sFilePath << std::endl;
+			return false;
+		}
+		const uint32_t uSession = uCurrentSession.load(std::memory_order_acquire);
+		const int64_t nStart = nSessionStart.load(std::memory_order_relaxed);
+		size_t uDropped = 0;
+		bool bFirst = true;
+		fout << std::fixed << std::setprecision(3);
+		fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		for (ThreadBuffer* pBuffer = pRegistry.load(std::memory_order_acquire); pBuffer; pBuffer = pBuffer->pNext) {
+			if (pBuffer->uSession.load(std::memory_order_acquire) != uSession) {
+				continue;
+			}
+			const size_t uCount = pBuffer->uCount.load(std::memory_order_acquire);
+			std::vector<Event> vecEvents;
+			if (uCount > 0) { // The events are allocated before the first count is published
+				vecEvents.assign(pBuffer->pEvents.get(), pBuffer->pEvents.get() + uCount);
+			}
+			std::sort(vecEvents.begin(), vecEvents.end(), [](const Event& lhs, const Event& rhs) {
+				return lhs.nBegin < rhs.nBegin || (lhs.nBegin == rhs.nBegin && lhs.nEnd > rhs.nEnd);
+				});
+			uDropped += uCount >= EVENTS_PER_THREAD ? 1 : 0;
+
+			if (const char* sName = pBuffer->sName.load(std::memory_order_relaxed)) {
+				fout << (bFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pBuffer->uThreadId;
+				fout << ",\"args\":{\"name\":";
+				WriteString(fout, sName);
+				fout << "}}";
+				bFirst = false;
+			}
+			for (const Event& event : vecEvents) {
+				if (event.nBegin < nStart) { // Entered before the session started
+					continue;
+				}
+				fout << (bFirst ? "\n" : ",\n") << "{\"name\":";
+				WriteString(fout, event.sName);
+				fout << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->uThreadId;
+				fout << ",\"ts\":" << static_cast<double>(event.nBegin - nStart) * 1e-3;
+				fout << ",\"dur\":" << static_cast<double>(event.nEnd - event.nBegin) * 1e-3 << "}";
+				bFirst = false;
+			}
+		}
+		fout << "\n]}\n";
+		if (uDropped > 0) {
+			std::cerr << "Trace buffers of " << uDropped << " threads were full, later zones were dropped" << std::endl;
+		}
+		return static_cast<bool>(fout);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////////// RECORDING /////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// @brief Current time of the monotonic clock in nanoseconds
+	int64_t GetTimestamp()
+	{
+		const auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+	}
+
+	/// @brief Record a closed zone in the buffer of the calling thread (dropped if the buffer is full)
+	/// @param sName Name of the zone (must outlive the session)
+	/// @param nBegin Time the zone was entered
+	/// @param nEnd Time the zone was left
+	void Record(const char* sName, const int64_t nBegin, const int64_t nEnd)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const uint32_t uSession = uCurrentSession.load(std::memory_order_acquire);
+		if (buffer.uSession.load(std::memory_order_relaxed) != uSession) { // Drop the previous session
+			buffer.uCount.store(0, std::memory_order_relaxed);
+			buffer.uSession.store(uSession, std::memory_order_release);
+		}
+		const size_t uCount = buffer.uCount.load(std::memory_order_relaxed);
+		if (uCount >= EVENTS_PER_THREAD) {
+			return;
+		}
+		if (!buffer.pEvents) {
+			buffer.pEvents.reset(new Event[EVENTS_PER_THREAD]); // Left uninitialized, only the published prefix is read
+		}
+		buffer.pEvents[uCount] = Event{ sName, nBegin, nEnd };
+		buffer.uCount.store(uCount + 1, std::memory_order_release);
+	}
+
+	/// @brief Name the calling thread in the exported traces
+	/// @param sName Name of the thread (must outlive the session, e.g. a string literal)
+	void SetThreadName(const char* sName)
+	{
+		GetThreadBuffer().sName.store(sName, std::memory_order_relaxed);
+	}
+}
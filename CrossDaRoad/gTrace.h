@@ -0,0 +1,78 @@
+#ifndef G_TRACE_H
+#define G_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @file gTrace.h
+ *
+ * @brief Contains trace zone macros, trace zone class and trace session functions
+ *
+ * This file contains the scoped trace zones of the engine. A zone records its name, thread and
+ * begin/end timestamps into a buffer owned by the calling thread (no lock, no allocation once the
+ * buffer exists), and a session can be exported as Chrome trace-event JSON, which opens in
+ * chrome://tracing, Perfetto (ui.perfetto.dev) or Speedscope.
+ *
+ * Zones are compiled out completely when TRACE_ZONES is not defined. When it is defined, a zone
+ * costs one atomic load while no session is recording.
+**/
+
+// Comment out to compile all trace zones out
+#define TRACE_ZONES
+
+#ifdef TRACE_ZONES
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+/// @brief Trace the enclosing scope under a name (string literal)
+#define TRACE_ZONE(name) const app_trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+/// @brief Trace the enclosing function under its name
+#define TRACE_FUNCTION() TRACE_ZONE(__FUNCTION__)
+/// @brief Name the calling thread in the exported traces (string literal)
+#define TRACE_THREAD(name) app_trace::SetThreadName(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_FUNCTION() ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+#endif
+
+/// @brief Scoped trace zones and trace sessions
+namespace app_trace
+{
+	/// @brief One closed zone of a thread (timestamps in nanoseconds of the monotonic clock)
+	struct Event
+	{
+		const char* sName; ///< Name of the zone (static string)
+		int64_t nBegin;    ///< Time the zone was entered
+		int64_t nEnd;      ///< Time the zone was left
+	};
+
+	/// @brief Scoped zone, recorded when it goes out of scope (use TRACE_ZONE instead)
+	class Zone
+	{
+	private:
+		const char* sName; ///< Name of the zone (static string)
+		int64_t nBegin;    ///< Time the zone was entered (-1 if no session was recording)
+
+	public: // Constructors & Destructor
+		explicit Zone(const char* sZoneName);
+		~Zone();
+		Zone(const Zone&) = delete;
+		Zone& operator=(const Zone&) = delete;
+	};
+
+	static constexpr size_t EVENTS_PER_THREAD = 1 << 16; ///< Zones kept per thread and session (later ones are dropped)
+
+	// Session
+	void Start();
+	void Stop();
+	bool IsRecording();
+	bool Export(const std::string& sFilePath);
+
+	// Recording
+	int64_t GetTimestamp();
+	void Record(const char* sName, int64_t nBegin, int64_t nEnd);
+	void SetThreadName(const char* sName);
+}
+
+#endif // G_TRACE_H
@@ -0,0 +1,96 @@
+#ifndef G_TRIPLE_BUFFER_H
+#define G_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file gTripleBuffer.h
+ *
+ * @brief Contains lock-free triple buffer class template
+ *
+ * This file contains a single-producer single-consumer triple buffer. The producer always owns one
+ * buffer to write, the consumer always owns one buffer to read, and the third buffer is exchanged
+ * between them through a single atomic byte, so neither side ever waits for the other.
+**/
+
+namespace app
+{
+	/// @brief Lock-free triple buffer, the consumer always gets the newest complete buffer
+	/// @tparam T Buffer type (the producer writes it in place, then publishes it)
+	template <class T>
+	class TripleBuffer
+	{
+	private:
+		static constexpr uint8_t INDEX_MASK = 0x3; ///< Bits of the buffer index in the shared slot
+		static constexpr uint8_t FRESH_BIT = 0x4;  ///< Set when the shared buffer was published and not yet taken
+
+	private:
+		std::array<T, 3> arrBuffers;       ///< The three buffers
+		uint8_t uWriteIndex;               ///< Buffer owned by the producer
+		std::atomic<uint8_t> uSharedIndex; ///< Buffer in exchange between producer and consumer (with FRESH_BIT)
+		uint8_t uReadIndex;                ///< Buffer owned by the consumer
+
+	public: // Constructors & Destructor
+		TripleBuffer() : uWriteIndex(0), uSharedIndex(1), uReadIndex(2) {}
+		~TripleBuffer() = default;
+		TripleBuffer(const TripleBuffer&) = delete;
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	public: // Setup (only while no other thread uses the buffer)
+		/// @brief Getter for any buffer by index, for initialization
+		T& GetBuffer(const int nIndex)
+		{
+			return arrBuffers[nIndex & INDEX_MASK];
+		}
+		/// @brief Forget a published but not taken buffer
+		void Reset()
+		{
+			uWriteIndex = 0;
+			uSharedIndex.store(1, std::memory_order_relaxed);
+			uReadIndex = 2;
+		}
+
+	public: // Producer
+		/// @brief Getter for the buffer being written by the producer
+		T& GetWriteBuffer()
+		{
+			return arrBuffers[uWriteIndex];
+		}
+		/// @brief Publish the written buffer and take another one to write
+		/// @return The buffer just published (still safe to read, it is never written by the consumer)
+		const T& Publish()
+		{
+			const uint8_t uPublished = uWriteIndex;
+			const uint8_t uPrevious = uSharedIndex.exchange(uPublished | FRESH_BIT, std::memory_order_acq_rel);
+			uWriteIndex = uPrevious & INDEX_MASK;
+			return arrBuffers[uPublished];
+		}
+
+	public: // Consumer
+		/// @brief Check if a buffer was published since the last acquisition
+		bool IsFresh() const
+		{
+			return (uSharedIndex.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+		}
+		/// @brief Take the newest published buffer, if any
+		/// @return true if the read buffer changed, false if nothing new was published
+		bool Acquire()
+		{
+			if (!IsFresh()) {
+				return false;
+			}
+			const uint8_t uPrevious = uSharedIndex.exchange(uReadIndex, std::memory_order_acq_rel);
+			uReadIndex = uPrevious & INDEX_MASK;
+			return true;
+		}
+		/// @brief Getter for the buffer being read by the consumer
+		const T& GetReadBuffer() const
+		{
+			return arrBuffers[uReadIndex];
+		}
+	};
+} // namespace app
+
+#endif // G_TRIPLE_BUFFER_H
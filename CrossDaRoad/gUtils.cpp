@@ -1,9 +1,15 @@
 #include "gUtils.h"
-#include <Windows.h>
 #include <iostream>
 #include <memory>
 #include <string>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <codecvt>
+#include <locale>
+#endif
+
 /**
  * @file gUtils.cpp
  *
@@ -23,6 +29,7 @@ namespace app
 	/// @return The converted wide string.
 	std::wstring to_wstring(const std::string& utf8String)
 	{
+#ifdef _WIN32
 		const int wideStringSize =
 			MultiByteToWideChar(CP_UTF8, 0, utf8String.c_str(), -1, nullptr, 0);
 		if (wideStringSize == 0) {
@@ -33,6 +40,14 @@ namespace app
 			return L"";
 		}
 		return std::wstring(wideBuffer.get());
+#else
+		try {
+			return std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(utf8String);
+		}
+		catch (const std::range_error&) {
+			return L"";
+		}
+#endif
 	}
 
 	/// @brief Converts a wide string to a string (wide string to UTF-8)
@@ -40,6 +55,7 @@ namespace app
 	/// @return The converted utf8 string.
 	std::string to_string(const std::wstring& wideString)
 	{
+#ifdef _WIN32
 		const int utf8StringSize = WideCharToMultiByte(CP_UTF8, 0, wideString.c_str(), -1, nullptr, 0, nullptr, nullptr);
 		if (utf8StringSize == 0) {
 			return "";
@@ -49,6 +65,14 @@ namespace app
 			return "";
 		}
 		return std::string(utf8Buffer.get());
+#else
+		try {
+			return std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(wideString);
+		}
+		catch (const std::range_error&) {
+			return "";
+		}
+#endif
 	}
 
 	static std::wstring WTEXT; // use local variable to avoid pointer issues
@@ -1,7 +1,6 @@
 #ifndef G_UTILS_H
 #define G_UTILS_H
 
-#include <Windows.h>
 #include <string>
 #include <memory>
 
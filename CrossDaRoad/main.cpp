@@ -1,10 +1,63 @@
 #include "cApp.h"
+#include "uBenchmark.h"
+#include <cstring>
+#include <cstdlib>
+#include <utility>
 
-int main()
+int main(int argc, char* argv[])
 {
+	if (argc > 1 && std::strcmp(argv[1], "--bench-map") == 0) {
+		const int nLaneCount = argc > 2 ? std::atoi(argv[2]) : 100000;
+		const int nSpriteCount = argc > 3 ? std::atoi(argv[3]) : 10000;
+		app_benchmark::BenchmarkMapParser(nLaneCount, nSpriteCount);
+		return 0;
+	}
+
 	cApp app;
 	if (app.Construct(app_const::SCREEN_WIDTH, app_const::SCREEN_HEIGHT, app_const::PIXEL_WIDTH, app_const::PIXEL_HEIGHT) == engine::SUCCESS) {
-		app.Start();
+		if (argc > 1 && std::strcmp(argv[1], "--headless") == 0) {
+			app::HeadlessOptions options;
+			options.uFrames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 600;
+			if (argc > 3 && !options.script.LoadFile(argv[3])) {
+				return 1;
+			}
+			app.StartHeadless(std::move(options));
+		}
+		else if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+			app::HeadlessOptions options; // Uncapped and reproducible: fixed seed, virtual time, profiled phases
+			options.uFrames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 6000;
+			options.uRenderInterval = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+			options.bFixedSeed = true;
+			options.uSeed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+			options.bProfile = true;
+			if (argc > 5 && !options.script.LoadFile(argv[5])) {
+				return 1;
+			}
+			app.StartHeadless(std::move(options));
+		}
+		else if (argc > 2 && std::strcmp(argv[1], "--record") == 0) {
+			app.RecordReplay(argv[2]);
+			app.Start();
+		}
+		else if (argc > 2 && std::strcmp(argv[1], "--replay") == 0) {
+			if (!app.LoadReplay(argv[2])) {
+				return 1;
+			}
+			if (argc > 3 && std::strcmp(argv[3], "--window") == 0) {
+				app.Start();
+			}
+			else {
+				app::HeadlessOptions options; // Until the end of the replay
+				options.uFrames = 0;
+				app.StartHeadless(std::move(options));
+				if (!app.GetReplaySummary().IsIdentical()) {
+					return 2;
+				}
+			}
+		}
+		else {
+			app.Start();
+		}
 	}
 	return 0;
 }
\ No newline at end of file
@@ -23,6 +23,14 @@ namespace app_const
 
 	constexpr int MAP_WIDTH_LIMIT = 64; ///< Map width limit (64) (in pixels)
 
+	constexpr unsigned RANDOM_SUMMON_DOMAIN = 1; ///< Random stream domain of summoning (indexed by map level)
+
+	constexpr int PIXEL_COLLISION_LEVEL = 15; ///< First map level using pixel-perfect collision by default (15)
+
+	constexpr float SIMULATION_RATE = 120.0f; ///< Fixed simulation rate, independent of frame rate (120) (in Hz)
+	constexpr bool SIMULATION_THREAD = true;  ///< Run the game on a simulation thread, frames presented by the engine thread (true)
+	constexpr bool FRAME_GOVERNOR = true;     ///< Adapt the frame delay to the frame work, shed summon effects when overloaded (true)
+
 	constexpr int SCREEN_WIDTH = 352;  ///< Screen width (352) (in pixels)
 	constexpr int SCREEN_HEIGHT = 160; ///< Screen height (160) (in pixels)
 
@@ -38,6 +46,15 @@ namespace app_const
 	constexpr int SPRITE_WIDTH = 16;  ///< Sprite width (16) (in pixels)
 	constexpr int SPRITE_HEIGHT = 16; ///< Sprite height (16) (in pixels)
 
+	constexpr float LOOP_FRAME_TIME = 0.15f;     ///< Frame time of looping animations: about us, score bar, tiles (0.15f) (in seconds)
+	constexpr float JUMP_FRAME_TIME = 0.03125f;  ///< Frame time of the jump, the frog moves once per frame (0.03125f) (in seconds)
+	constexpr float DEATH_FRAME_TIME = 0.1f;     ///< Frame time of the death animation (0.1f) (in seconds)
+	constexpr int ABOUT_US_FRAMES = 4;  ///< Number of about us pages (4)
+	constexpr int SCORE_BAR_FRAMES = 4; ///< Number of score bar frames (4)
+	constexpr int JUMP_FRAMES = 6;      ///< Number of jump frames (6)
+	constexpr int JUMP_SAFE_FRAME = 6;  ///< Last jump frame where the frog can be hit, the smaller the stricter (6)
+	constexpr int DEATH_FRAMES = 6;     ///< Number of death frames (6)
+
 	constexpr float FROG_X_VELOCITY = 1.0; ///< Frog x velocity (1.0)
 	constexpr float FROG_Y_VELOCITY = 1.0; ///< Frog y velocity (1.0)
 	constexpr float FROG_X_RESET = 8.0f;   ///< Frog x reset position (8.0f)
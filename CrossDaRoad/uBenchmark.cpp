@@ -0,0 +1,91 @@
+#include "uBenchmark.h"
+#include "cMapLoader.h"
+#include "uAppConst.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @file uBenchmark.cpp
+ *
+ * @brief Contains benchmark utilities implementation
+ *
+ * This file implements benchmark functions for measuring game subsystems outside of the game loop.
+**/
+
+namespace app_benchmark
+{
+	/// @brief Generate a synthetic map file in the same format as data/maps/map*.txt
+	/// @param nLaneCount Number of lanes (each lane is MAP_WIDTH_LIMIT tiles)
+	/// @param nSpriteCount Number of sprite definitions (encodes are reused cyclically)
+	/// @return Content of the map file
+	std::string GenerateMap(const int nLaneCount, const int nSpriteCount)
+	{
+		constexpr char sEncodes[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.,";
+		constexpr int nEncodeCount = sizeof(sEncodes) - 1;
+
+		std::string sMap;
+		sMap.reserve(static_cast<size_t>(nLaneCount) * (app_const::MAP_WIDTH_LIMIT + 8) + static_cast<size_t>(nSpriteCount) * 128);
+		for (int nLane = 0; nLane < nLaneCount; nLane++) {
+			for (int nCol = 0; nCol < app_const::MAP_WIDTH_LIMIT; nCol++) {
+				sMap += sEncodes[(nLane * 7 + nCol * 13 + nCol / 5) % nEncodeCount];
+			}
+			sMap += ' ';
+			sMap += std::to_string(nLane % 9 - 4);
+			sMap += ".5\n";
+		}
+		sMap += "#\n";
+		for (int nSprite = 0; nSprite < nSpriteCount; nSprite++) {
+			const char encode = sEncodes[nSprite % nEncodeCount];
+			sMap += "$ ";
+			sMap += encode;
+			sMap += " sprite=sprite" + std::to_string(nSprite % 97) + " background=soil\n";
+			sMap += ": block=" + std::string(nSprite % 5 == 0 ? "true" : "false");
+			sMap += " danger=" + std::string(nSprite % 3 == 0 ? "true" : "false");
+			sMap += " platformspeed=" + std::to_string(nSprite % 11) + ".25\n";
+			sMap += ": spriteX=" + std::to_string(nSprite % 4) + " spriteY=" + std::to_string(nSprite % 3);
+			if (nSprite % 17 == 0) {
+				sMap += " summon=";
+				sMap += sEncodes[(nSprite + 1) % nEncodeCount];
+				sMap += " duration=1.5s cooldown=300ms chance=50%";
+			}
+			sMap += '\n';
+		}
+		sMap += "#\n";
+		return sMap;
+	}
+
+	/// @brief Measure parsing throughput of cMapLoader on a synthetic map held in memory
+	/// @param nLaneCount Number of lanes
+	/// @param nSpriteCount Number of sprite definitions
+	/// @param nRepeat Number of measured parses
+	/// @return Benchmark result (also printed to std::cout)
+	MapParserResult BenchmarkMapParser(const int nLaneCount, const int nSpriteCount, const int nRepeat)
+	{
+		const std::string sMap = GenerateMap(nLaneCount, nSpriteCount);
+		MapParserResult result{ nLaneCount, nSpriteCount, sMap.size(), 0, 0.0, 0.0 };
+
+		cMapLoader loader;
+		double fTotalSeconds = 0.0;
+		for (int nIter = 0; nIter < std::max(nRepeat, 1); nIter++) {
+			loader.MapClear();
+			const auto start = std::chrono::steady_clock::now();
+			loader.LoadMapBuffer(sMap);
+			const auto end = std::chrono::steady_clock::now();
+			const double fSeconds = std::chrono::duration<double>(end - start).count();
+			result.fBestSeconds = nIter == 0 ? fSeconds : std::min(result.fBestSeconds, fSeconds);
+			fTotalSeconds += fSeconds;
+		}
+		result.fMeanSeconds = fTotalSeconds / std::max(nRepeat, 1);
+		result.nDiagnostics = loader.GetDiagnostics().size();
+
+		const double fMegabytes = static_cast<double>(result.nBytes) / (1024.0 * 1024.0);
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "Map parser: " << nLaneCount << " lanes, " << nSpriteCount << " sprites, " << fMegabytes << " MiB" << std::endl;
+		std::cout << "  best " << result.fBestSeconds * 1e3 << " ms (" << fMegabytes / result.fBestSeconds << " MiB/s)";
+		std::cout << ", mean " << result.fMeanSeconds * 1e3 << " ms";
+		std::cout << ", lanes loaded " << loader.GetLanes().size();
+		std::cout << ", diagnostics " << result.nDiagnostics << std::endl;
+		return result;
+	}
+}
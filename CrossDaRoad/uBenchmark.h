@@ -0,0 +1,33 @@
+#ifndef U_BENCHMARK_H
+#define U_BENCHMARK_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file uBenchmark.h
+ *
+ * @brief Contains benchmark utilities
+ *
+ * This file contains benchmark function prototypes for measuring game subsystems outside of the game loop.
+**/
+
+/// @brief Benchmark utilities
+namespace app_benchmark
+{
+	/// @brief Result of a map parser benchmark
+	struct MapParserResult
+	{
+		int nLaneCount;      ///< Number of lanes in the synthetic map
+		int nSpriteCount;    ///< Number of sprite definitions in the synthetic map
+		size_t nBytes;       ///< Size of the synthetic map (in bytes)
+		size_t nDiagnostics; ///< Number of diagnostics reported by the parser (expected 0)
+		double fBestSeconds; ///< Fastest parsing time among all repeats (in seconds)
+		double fMeanSeconds; ///< Mean parsing time among all repeats (in seconds)
+	};
+
+	std::string GenerateMap(int nLaneCount, int nSpriteCount);
+	MapParserResult BenchmarkMapParser(int nLaneCount = 100000, int nSpriteCount = 10000, int nRepeat = 5);
+}
+
+#endif // U_BENCHMARK_H
@@ -1,16 +1,20 @@
 #include "uSound.h"
 
-#pragma comment(lib, "winmm.lib")
-#include <Windows.h>
 #include <iostream>
 #include <thread>
 
+#ifdef _WIN32
+#pragma comment(lib, "winmm.lib")
+#include <Windows.h>
+#endif
+
 /**
  * @file uSound.cpp
  *
  * @brief Contains sound functions
  *
- * This file implements sound functions.
+ * This file implements sound functions with the MCI of Windows. Other platforms have no sound
+ * backend: nothing is played, and the functions that report success return false.
  **/
 
 namespace app_sound
@@ -20,12 +24,16 @@ namespace app_sound
 	/// @return True if the music thread is stopped successfully, false otherwise
 	bool StopMusic(const std::string& alias)
 	{
+#ifdef _WIN32
 		const std::string command = "stop " + alias;
 		if (mciSendStringA(command.c_str(), nullptr, 0, nullptr) != 0) {
 			std::cerr << "Failed to stop the music." << std::endl;
 			return false;
 		}
 		return true;
+#else
+		return false;
+#endif
 	}
 
 	/// @brief Plays a custom sound with the given alias name and audio
@@ -35,6 +43,7 @@ namespace app_sound
 	bool PlayCustomSound(const std::string& audioFilePath, const std::string& alias)
 	{
 		CloseMusicThread(alias);
+#ifdef _WIN32
 		const std::string command = "open \"" + audioFilePath + "\" type waveaudio alias " + alias;
 		if (mciSendStringA(command.c_str(), nullptr, 0, nullptr) != 0) {
 			std::cerr << "Can not open music file (" << audioFilePath << ")" << std::endl;
@@ -43,6 +52,9 @@ namespace app_sound
 		const std::string playCommand = "play " + alias;
 		mciSendStringA(playCommand.c_str(), nullptr, 0, nullptr);
 		return true;
+#else
+		return false;
+#endif
 	}
 
 	/// @brief Plays a WAV file with the given alias name and audio
@@ -72,8 +84,10 @@ namespace app_sound
 	/// @return Always returns true by default
 	bool CloseMusicThread(const std::string& alias)
 	{
+#ifdef _WIN32
 		const std::string command = "close " + alias;
 		mciSendStringA(command.c_str(), nullptr, 0, nullptr);
+#endif
 		return true;
 	}
 
@@ -119,6 +133,7 @@ namespace app_sound
 	/// @return True if the music is playing, false otherwise
 	bool IsMusicPlaying()
 	{
+#ifdef _WIN32
 		MCI_STATUS_PARMS statusParams;
 		statusParams.dwItem = MCI_STATUS_MODE;
 		mciSendCommand(MCI_ALL_DEVICE_ID, MCI_STATUS, MCI_WAIT | MCI_STATUS_ITEM, reinterpret_cast<DWORD_PTR>(&statusParams));
@@ -129,5 +144,8 @@ namespace app_sound
 		else {
 			return false;
 		}
+#else
+		return false;
+#endif
 	}
 } // namespace app_sound
@@ -1,4 +1,5 @@
 #include "uStringUtils.h"
+#include <cstring>
 
 /**
  * @file uStringUtils.cpp